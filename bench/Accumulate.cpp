@@ -0,0 +1,72 @@
+// Scatter-add policies of Accumulate.h against each other at varying contention.
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/Accumulate.h"
+
+namespace Bench {
+    namespace {
+        using V = Geometry::Vector3f;
+
+        /// `contributions` random contributions spread over contributions / `per_target` targets.
+        void measure(std::size_t contributions, std::size_t per_target, unsigned int threads) {
+            const auto target_count = contributions / per_target;
+            std::mt19937 engine(3);
+            std::uniform_int_distribution<std::uint32_t> target(0, static_cast<std::uint32_t>(target_count - 1));
+            std::uniform_real_distribution<float> force(-1.0f, 1.0f);
+            std::vector<std::uint32_t> indices(contributions);
+            std::vector<V> values(contributions);
+            for (std::size_t i = 0; i < contributions; ++i) {
+                indices[i] = target(engine);
+                values[i] = V(force(engine), force(engine), force(engine));
+            }
+            std::vector<V> targets(target_count);
+            const std::span<V> out(targets);
+            const std::span<const std::uint32_t> in_indices(indices);
+            const std::span<const V> in_values(values);
+            const auto schedule = Geometry::ColorSchedule::build(in_indices, target_count);
+            const auto reps = repetitions(contributions, std::size_t{1} << 22);
+            const auto ns = [contributions](double seconds) {
+                return seconds / static_cast<double>(contributions) * 1e9;
+            };
+
+            const auto serial = best_time([&] {
+                for (std::size_t i = 0; i < contributions; ++i) {
+                    out[indices[i]] = out[indices[i]] + values[i];
+                }
+                keep(out.data());
+            }, reps);
+            const auto run = [&](Geometry::AccumulatePolicy policy) {
+                return best_time([&] {
+                    Geometry::scatter_add(out, in_indices, in_values, policy, threads);
+                    keep(out.data());
+                }, reps);
+            };
+            const auto atomic = run(Geometry::AccumulatePolicy::Atomic);
+            const auto privatized = run(Geometry::AccumulatePolicy::Privatized);
+            const auto colored = best_time([&] {
+                Geometry::scatter_add(out, in_indices, in_values, schedule, threads);
+                keep(out.data());
+            }, reps);
+            std::printf("| %-18zu | %-6zu | %-6.1f | %-6.1f | %-10.1f | %-7.1f |\n", per_target,
+                        schedule.color_count(), ns(serial), ns(atomic), ns(privatized), ns(colored));
+        }
+    } // namespace
+
+    void accumulate() {
+        constexpr std::size_t contributions = std::size_t{1} << 20;
+        const auto threads = Geometry::default_thread_count();
+        std::printf("ns per contribution, 1M Vector3f contributions, threads: %u; serial is one thread"
+                    " without synchronization, colored reuses a prebuilt schedule:\n\n", threads);
+        std::printf("| Hits per target    | Colors | Serial | Atomic | Privatized | Colored |\n");
+        std::printf("|--------------------|--------|--------|--------|------------|---------|\n");
+        for (const std::size_t per_target: {1, 4, 16, 64}) {
+            measure(contributions, per_target, threads);
+        }
+    }
+} // namespace Bench
@@ -0,0 +1,94 @@
+/**
+ * @file Bench.h
+ * @brief Timing helpers and registry of the `bench` target.
+ *
+ * Each benchmark prints the table quoted in the header it measures, so the numbers there
+ * can be reproduced on other machines: `bench` runs all of them, `bench layouts transpose`
+ * only the ones named. Configure with -DBENCH_NATIVE=ON for the -march=native columns.
+ * Requires C++20
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+
+namespace Bench {
+    /// @brief Best of `runs` timings of `reps` calls to `fn`, in seconds per call.
+    template<typename Fn>
+    [[nodiscard]] double best_time(Fn &&fn, std::size_t reps, int runs = 7) {
+        fn();
+        auto best = std::chrono::duration<double>::max().count();
+        for (int run = 0; run < runs; ++run) {
+            const auto start = std::chrono::steady_clock::now();
+            for (std::size_t r = 0; r < reps; ++r) {
+                fn();
+            }
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count() / static_cast<double>(reps));
+        }
+        return best;
+    }
+
+    /// @brief Calls per run so that a run processes about `total` elements of `count`.
+    [[nodiscard]] inline std::size_t repetitions(std::size_t count, std::size_t total = std::size_t{1} << 25) {
+        return std::max<std::size_t>(1, total / count);
+    }
+
+    /// @brief Let `data` escape, so the stores producing it are not removed.
+    inline void keep(const void *data) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "g"(data) : "memory");
+#else
+        [[maybe_unused]] static const void *volatile sink;
+        sink = data;
+#endif
+    }
+
+    /// @brief Array sizes, in elements: Vector3f arrays fitting in L2, and arrays of 192 MB,
+    ///        beyond the last-level cache of current server parts.
+    inline constexpr std::size_t cache_count = 16 * 1024;
+    inline constexpr std::size_t memory_count = 16 * 1024 * 1024;
+
+    /// @name Benchmarks, one per file of bench/.
+    /// @{
+    void layouts();
+    void transpose();
+    void snapshot();
+    void polynomial();
+    void views();
+    void accumulate();
+    void gather();
+    void mapped_array();
+    void skinning();
+    void culling();
+    void lighting();
+    void costs();
+    /// @}
+
+    struct Entry {
+        std::string_view name;
+        void (*run)();
+    };
+
+    inline constexpr Entry benchmarks[] = {
+        {"layouts", layouts},
+        {"transpose", transpose},
+        {"snapshot", snapshot},
+        {"polynomial", polynomial},
+        {"views", views},
+        {"accumulate", accumulate},
+        {"gather", gather},
+        {"mapped_array", mapped_array},
+        {"skinning", skinning},
+        {"culling", culling},
+        {"lighting", lighting},
+        {"costs", costs},
+    };
+} // namespace Bench
+
+#endif // BENCH_H
@@ -0,0 +1,97 @@
+// Per-element costs of the batched kernels against the estimates of element_cost_ns (Parallel.h).
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/Quantize.h"
+#include "../source/Quaternion.h"
+#include "../source/Transform3.h"
+#include "../source/VectorAlgorithms.h"
+#include "../source/VectorViews.h"
+
+namespace Bench {
+    void costs() {
+        using V = Geometry::Vector3f;
+        namespace cost = Geometry::element_cost_ns;
+        constexpr std::size_t n = cache_count;
+        std::mt19937 engine(19);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<V> source(n), result(n), shuffled(n);
+        for (auto &v: source) {
+            v = V(unit(engine), unit(engine), unit(engine));
+        }
+        std::vector<Geometry::OctEncoded<16>> encoded(n);
+        const std::span<const V> in(source);
+        const std::span<V> out(result), sorted(shuffled);
+        const std::span<Geometry::OctEncoded<16>> octahedral(encoded);
+        const auto model = Geometry::Transform3f(Geometry::Quaternion<float>::from_axis_angle(V(0.0f, 0.0f, 1.0f), 0.5f),
+                                                 V(1.0f, 2.0f, 3.0f));
+        const auto reps = repetitions(n);
+        const auto ns = [&](auto &&fn) { return best_time(fn, reps) / static_cast<double>(n) * 1e9; };
+
+        const auto transform = ns([&] {
+            Geometry::transform(in, out, [](const V &v) { return v * 2.0f; });
+            keep(out.data());
+        });
+        V total;
+        const auto reduce = ns([&] {
+            total = Geometry::reduce(in);
+            keep(&total);
+        });
+        const auto normalize = ns([&] {
+            Geometry::normalize(in, out);
+            keep(out.data());
+        });
+        // Includes the copy restoring the unsorted input, about one `transform` per element.
+        const auto sort = ns([&] {
+            std::copy(in.begin(), in.end(), sorted.begin());
+            Geometry::sort_by_key(sorted, [](const V &v) { return v[0]; });
+            keep(sorted.data());
+        }) / static_cast<double>(std::bit_width(n - 1));
+        const auto transform3 = ns([&] {
+            model.transform_points(in, out);
+            keep(out.data());
+        });
+        const auto encode = ns([&] {
+            Geometry::encode_octahedral<16>(in, octahedral);
+            keep(octahedral.data());
+        });
+        const auto decode = ns([&] {
+            Geometry::decode_octahedral(std::span<const Geometry::OctEncoded<16>>(octahedral), out);
+            keep(out.data());
+        });
+        // One stage against four: the difference is three stages, the rest the transposes.
+        const auto one_stage = ns([&] {
+            Geometry::materialize(in | Geometry::views::scaled(2.0f), out);
+            keep(out.data());
+        });
+        const auto four_stages = ns([&] {
+            Geometry::materialize(in | Geometry::views::scaled(2.0f) | Geometry::views::scaled(0.5f)
+                                  | Geometry::views::scaled(2.0f) | Geometry::views::scaled(0.5f), out);
+            keep(out.data());
+        });
+        const auto stage = std::max(four_stages - one_stage, 0.0) / 3.0;
+        const auto transpose = Geometry::pipeline_chunked ? std::max(one_stage - stage, 0.0) : 0.0;
+
+        std::printf("ns per element, Vector3f, 16K elements, one thread:\n\n");
+        std::printf("| Cost               | Estimate | Measured |\n");
+        std::printf("|--------------------|----------|----------|\n");
+        const auto row = [](const char *name, double estimate, double measured) {
+            std::printf("| %-18s | %-8.1f | %-8.2f |\n", name, estimate, measured);
+        };
+        row("transform", cost::transform, transform);
+        row("reduce", cost::reduce, reduce);
+        row("normalize", cost::normalize, normalize);
+        row("sort (per level)", cost::sort, sort);
+        row("transform3", cost::transform3, transform3);
+        row("encode_octahedral", cost::encode_octahedral, encode);
+        row("decode_octahedral", cost::decode_octahedral, decode);
+        row("pipeline_transpose", Geometry::pipeline_chunked ? cost::pipeline_transpose : 0.0, transpose);
+        row("pipeline_stage", cost::pipeline_stage, stage);
+    }
+} // namespace Bench
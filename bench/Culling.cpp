@@ -0,0 +1,117 @@
+// Objects culled per microsecond by the flat and hierarchical kernels of Culling.h.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/Culling.h"
+
+namespace Bench {
+    namespace {
+        using V = Geometry::Vector3f;
+
+        /// Depth-first median-split tree over the boxes, leaves of up to `leaf_size` objects.
+        /// Reorders `order` so that every subtree owns a contiguous range of it.
+        struct TreeBuilder {
+            static constexpr std::size_t leaf_size = 16;
+            std::span<const V> mins, maxs;
+            std::vector<std::uint32_t> order;
+            std::vector<Geometry::CullNode<float>> nodes;
+
+            void build(std::size_t begin, std::size_t end) {
+                V lo = mins[order[begin]], hi = maxs[order[begin]];
+                for (auto k = begin; k < end; ++k) {
+                    for (auto c = 0u; c < 3; ++c) {
+                        lo[c] = std::min(lo[c], mins[order[k]][c]);
+                        hi[c] = std::max(hi[c], maxs[order[k]][c]);
+                    }
+                }
+                const auto index = nodes.size();
+                nodes.push_back({lo, hi, 0, static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(end - begin)});
+                if (end - begin > leaf_size) {
+                    const auto extent = hi - lo;
+                    const auto axis = extent[0] > extent[1] ? (extent[0] > extent[2] ? 0u : 2u)
+                                                            : (extent[1] > extent[2] ? 1u : 2u);
+                    const auto middle = begin + (end - begin) / 2;
+                    std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+                                     [&](std::uint32_t a, std::uint32_t b) {
+                                         return mins[a][axis] + maxs[a][axis] < mins[b][axis] + maxs[b][axis];
+                                     });
+                    build(begin, middle);
+                    build(middle, end);
+                }
+                nodes[index].skip = static_cast<std::uint32_t>(nodes.size());
+            }
+        };
+    } // namespace
+
+    void culling() {
+        constexpr std::size_t objects = std::size_t{1} << 18;
+        std::mt19937 engine(13);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f), size(0.1f, 2.0f);
+        std::vector<V> box_mins(objects), box_maxs(objects);
+        for (std::size_t i = 0; i < objects; ++i) {
+            box_mins[i] = V(position(engine), position(engine), position(engine));
+            box_maxs[i] = box_mins[i] + V(size(engine), size(engine), size(engine));
+        }
+
+        // Objects stored in tree order, so all kernels see the same layout.
+        TreeBuilder tree{box_mins, box_maxs, std::vector<std::uint32_t>(objects), {}};
+        std::iota(tree.order.begin(), tree.order.end(), 0u);
+        tree.build(0, objects);
+        Geometry::SoAArray<3, float> mins(objects), maxs(objects), centers(objects);
+        std::vector<float> radii(objects);
+        for (std::size_t i = 0; i < objects; ++i) {
+            const auto &lo = box_mins[tree.order[i]], &hi = box_maxs[tree.order[i]];
+            mins.span().store(i, lo);
+            maxs.span().store(i, hi);
+            centers.span().store(i, (lo + hi) * 0.5f);
+            radii[i] = (hi - lo).magnitude() * 0.5f;
+        }
+
+        // 90 degree pyramid at the origin looking down +z, from z = 1 to z = 100: about 1/6 of the world.
+        const Geometry::Frustum<float> frustum({
+            Geometry::Vector<4, float>(1.0f, 0.0f, 1.0f, 0.0f), Geometry::Vector<4, float>(-1.0f, 0.0f, 1.0f, 0.0f),
+            Geometry::Vector<4, float>(0.0f, 1.0f, 1.0f, 0.0f), Geometry::Vector<4, float>(0.0f, -1.0f, 1.0f, 0.0f),
+            Geometry::Vector<4, float>(0.0f, 0.0f, 1.0f, -1.0f), Geometry::Vector<4, float>(0.0f, 0.0f, -1.0f, 100.0f)
+        });
+
+        const auto &bounds_mins = mins, &bounds_maxs = maxs, &sphere_centers = centers;
+        std::vector<std::uint32_t> visible;
+        const auto reps = repetitions(objects, std::size_t{1} << 22);
+        const auto row = [&](const char *test, unsigned int threads, double seconds) {
+            std::printf("| %-17s | %-7u | %-10.0f | %-7zu |\n", test, threads,
+                        static_cast<double>(objects) / seconds * 1e-6, visible.size());
+        };
+        const auto flat = [&](unsigned int threads) {
+            row("Spheres", threads, best_time([&] {
+                Geometry::cull_spheres(frustum, sphere_centers.span(), std::span<const float>(radii), visible, threads);
+                keep(visible.data());
+            }, reps));
+            row("AABBs", threads, best_time([&] {
+                Geometry::cull_aabbs(frustum, bounds_mins.span(), bounds_maxs.span(), visible, threads);
+                keep(visible.data());
+            }, reps));
+        };
+
+        std::printf("Objects per microsecond, 256K objects in a 200 m cube, tree of %zu nodes:\n\n",
+                    tree.nodes.size());
+        std::printf("| Test              | Threads | Objects/us | Visible |\n");
+        std::printf("|-------------------|---------|------------|---------|\n");
+        flat(1);
+        if (Geometry::default_thread_count() > 1) {
+            flat(Geometry::default_thread_count());
+        }
+        row("AABB hierarchy", 1, best_time([&] {
+            Geometry::cull_hierarchy(frustum, std::span<const Geometry::CullNode<float>>(tree.nodes),
+                                     bounds_mins.span(), bounds_maxs.span(), visible);
+            keep(visible.data());
+        }, reps));
+    }
+} // namespace Bench
@@ -0,0 +1,63 @@
+// Prefetch distance sweep over the gather / scatter kernels of Gather.h.
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/Gather.h"
+
+namespace Bench {
+    void gather() {
+        using V = Geometry::Vector3f;
+        // Random reads into a source array beyond the last-level cache: the latency-bound case.
+        constexpr std::size_t reads = std::size_t{1} << 20;
+        constexpr std::size_t tile_elements = std::size_t{1} << 14;
+        std::vector<V> source(memory_count);
+        for (std::size_t i = 0; i < memory_count; ++i) {
+            source[i] = V(static_cast<float>(i), 1.0f, 2.0f);
+        }
+        std::mt19937 engine(5);
+        std::uniform_int_distribution<std::uint32_t> index(0, static_cast<std::uint32_t>(memory_count - 1));
+        std::vector<std::uint32_t> indices(reads);
+        for (auto &i: indices) {
+            i = index(engine);
+        }
+        const auto tiled = Geometry::tile_indices(indices, tile_elements);
+        std::vector<V> gathered(reads), values(reads, V(1.0f, 1.0f, 1.0f));
+        Geometry::SoAArray<3, float> lanes(reads);
+        const std::span<const V> src(source), in_values(values);
+        const std::span<V> dst(gathered), targets(source);
+        const std::span<const std::uint32_t> in_indices(indices);
+        const auto soa = lanes.span();
+        const auto ns = [](double seconds) { return seconds / static_cast<double>(reads) * 1e9; };
+
+        std::printf("ns per index, 1M random indices into 16M Vector3f (192 MB), tiles of %zu elements:\n\n",
+                    tile_elements);
+        std::printf("| Prefetch distance | AoS gather | Tiled gather | SoA gather | Scatter-add |\n");
+        std::printf("|-------------------|------------|--------------|------------|-------------|\n");
+        for (const std::size_t distance: {0, 4, 8, 16, 32, 64, 128}) {
+            // Distance 0 prefetches the element being read, which is the same as no prefetch.
+            const auto aos = best_time([&] {
+                Geometry::gather(src, in_indices, dst, distance);
+                keep(dst.data());
+            }, 1, 3);
+            const auto tiled_time = best_time([&] {
+                Geometry::gather(src, tiled, dst, distance);
+                keep(dst.data());
+            }, 1, 3);
+            const auto soa_time = best_time([&] {
+                Geometry::gather(src, in_indices, soa, distance);
+                keep(soa.component(0).data());
+            }, 1, 3);
+            const auto scatter = best_time([&] {
+                Geometry::scatter_add(targets, in_indices, in_values, distance);
+                keep(targets.data());
+            }, 1, 3);
+            std::printf("| %-17zu | %-10.1f | %-12.1f | %-10.1f | %-11.1f |\n", distance, ns(aos), ns(tiled_time),
+                        ns(soa_time), ns(scatter));
+        }
+    }
+} // namespace Bench
@@ -0,0 +1,143 @@
+// AoS / SoA / AoSoA comparison of VectorBlockArray.h.
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/SoA.h"
+#include "../source/VectorBlockArray.h"
+
+namespace Bench {
+    namespace {
+        using V = Geometry::Vector3f;
+
+        struct LayoutTimes {
+            double soa;
+            double blocks;
+        };
+
+        /// Time of the SoA and AoSoA forms of one operation, relative to AoS.
+        template<typename Aos, typename Soa, typename Blocks>
+        LayoutTimes relative(std::size_t reps, Aos &&aos, Soa &&soa, Blocks &&blocks) {
+            const auto base = best_time(aos, reps);
+            return {best_time(soa, reps) / base, best_time(blocks, reps) / base};
+        }
+
+        std::array<LayoutTimes, 4> measure(std::size_t n) {
+            std::mt19937 engine(1);
+            std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+            std::vector<V> a(n), b(n), out(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                a[i] = V(uniform(engine), uniform(engine), uniform(engine));
+                b[i] = V(uniform(engine), uniform(engine), uniform(engine));
+            }
+            std::vector<float> dots(n);
+            Geometry::SoAArray<3, float> soa_a(n), soa_b(n), soa_out(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                soa_a.span().store(i, a[i]);
+                soa_b.span().store(i, b[i]);
+            }
+            const Geometry::Vector3fBlockArray blocks_a{std::span<const V>(a)}, blocks_b{std::span<const V>(b)};
+            Geometry::Vector3fBlockArray blocks_out(n);
+
+            const auto sa = std::as_const(soa_a).span(), sb = std::as_const(soa_b).span();
+            const auto ax = sa.component(0), ay = sa.component(1), az = sa.component(2);
+            const auto bx = sb.component(0), by = sb.component(1), bz = sb.component(2);
+            const auto so = soa_out.span();
+            const auto ox = so.component(0), oy = so.component(1), oz = so.component(2);
+            const auto reps = repetitions(n);
+
+            // The SoA loops are the one-pass ones a user would write over separate arrays.
+            std::array<LayoutTimes, 4> times;
+            times[0] = relative(reps, [&] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    dots[i] = a[i].dot(b[i]);
+                }
+                keep(dots.data());
+            }, [&] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    dots[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+                }
+                keep(dots.data());
+            }, [&] {
+                Geometry::dot(blocks_a, blocks_b, std::span<float>(dots));
+                keep(dots.data());
+            });
+            times[1] = relative(reps, [&] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    out[i] = a[i].cross(b[i]);
+                }
+                keep(out.data());
+            }, [&] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    ox[i] = ay[i] * bz[i] - az[i] * by[i];
+                    oy[i] = az[i] * bx[i] - ax[i] * bz[i];
+                    oz[i] = ax[i] * by[i] - ay[i] * bx[i];
+                }
+                keep(ox.data());
+            }, [&] {
+                Geometry::cross(blocks_a, blocks_b, blocks_out);
+                keep(&blocks_out.block(0));
+            });
+            times[2] = relative(reps, [&] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    out[i] = a[i].normalized();
+                }
+                keep(out.data());
+            }, [&] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    const auto inv_length = 1.0f / std::sqrt(ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i]);
+                    ox[i] = ax[i] * inv_length;
+                    oy[i] = ay[i] * inv_length;
+                    oz[i] = az[i] * inv_length;
+                }
+                keep(ox.data());
+            }, [&] {
+                Geometry::normalize(blocks_a, blocks_out);
+                keep(&blocks_out.block(0));
+            });
+
+            std::vector<std::uint32_t> indices(n);
+            for (auto &index: indices) {
+                index = static_cast<std::uint32_t>(engine() % n);
+            }
+            float sum = 0.0f;
+            const auto add = [&sum](const V &v) { sum += v[0] + v[1] + v[2]; };
+            times[3] = relative(reps / 4 + 1, [&] {
+                for (const auto i: indices) {
+                    add(a[i]);
+                }
+                keep(&sum);
+            }, [&] {
+                for (const auto i: indices) {
+                    add(sa.load(i));
+                }
+                keep(&sum);
+            }, [&] {
+                for (const auto i: indices) {
+                    add(blocks_a.load(i));
+                }
+                keep(&sum);
+            });
+            return times;
+        }
+    } // namespace
+
+    void layouts() {
+        const auto cache = measure(cache_count), memory = measure(memory_count);
+        const char *names[] = {"dot", "cross", "normalize", "random access (load + sum)"};
+        std::printf("Time per element relative to AoS std::vector<Vector3f>, %zu and %zu elements:\n\n",
+                    cache_count, memory_count);
+        std::printf("| Operation                  | SoA, L2 | AoSoA, L2 | SoA, DRAM | AoSoA, DRAM |\n");
+        std::printf("|----------------------------|---------|-----------|-----------|-------------|\n");
+        for (std::size_t op = 0; op < cache.size(); ++op) {
+            std::printf("| %-26s | %-7.2f | %-9.2f | %-9.2f | %-11.2f |\n", names[op], cache[op].soa,
+                        cache[op].blocks, memory[op].soa, memory[op].blocks);
+        }
+    }
+} // namespace Bench
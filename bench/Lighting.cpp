@@ -0,0 +1,78 @@
+// Phong lighting with defensively normalized plain vectors against UnitVector (Vector.h).
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/Vector.h"
+
+namespace Bench {
+    namespace {
+        using V = Geometry::Vector3f;
+        using U = Geometry::UnitVector3f;
+
+        /// Diffuse + specular (exponent 16) terms from n . l and r . (-l), r the view direction mirrored about n.
+        float shade(float n_dot_l, float r_dot_l) {
+            auto specular = std::max(r_dot_l, 0.0f);
+            specular *= specular;
+            specular *= specular;
+            specular *= specular;
+            specular *= specular;
+            return std::max(n_dot_l, 0.0f) + specular;
+        }
+    } // namespace
+
+    void lighting() {
+        std::mt19937 engine(17);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::vector<V> positions(cache_count), normals(cache_count);
+        std::vector<U> unit_normals;
+        unit_normals.reserve(cache_count);
+        for (std::size_t i = 0; i < cache_count; ++i) {
+            positions[i] = V(unit(engine), unit(engine), unit(engine));
+            normals[i] = V(unit(engine), unit(engine), 1.5f).normalized();
+            unit_normals.push_back(U::from_unit(normals[i]));
+        }
+        const V light(2.0f, 3.0f, 4.0f), eye(0.0f, 0.0f, 5.0f);
+        std::vector<float> radiance(cache_count);
+        const auto reps = repetitions(cache_count);
+
+        // Every function renormalizes what it is given, since a plain Vector carries no guarantee.
+        const auto plain = best_time([&] {
+            for (std::size_t i = 0; i < cache_count; ++i) {
+                V n = normals[i];
+                n.normalize();
+                V l = light - positions[i];
+                l.normalize();
+                V v = positions[i] - eye;
+                v.normalize();
+                V r = Geometry::reflect(v, n);
+                r.normalize();
+                radiance[i] = shade(n.dot(l), -r.dot(l));
+            }
+            keep(radiance.data());
+        }, reps);
+        // The same code on UnitVector: the normal is not renormalized, reflect skips its
+        // division by n . n and the result of reflect is already unit length.
+        const auto typed = best_time([&] {
+            for (std::size_t i = 0; i < cache_count; ++i) {
+                U n = unit_normals[i];
+                n.normalize();
+                const U l = (light - positions[i]).normalized();
+                const U v = (positions[i] - eye).normalized();
+                U r = Geometry::reflect(v, n);
+                r.normalize();
+                radiance[i] = shade(n.dot(l), -r.dot(l));
+            }
+            keep(radiance.data());
+        }, reps);
+
+        const auto ns = [](double seconds) { return seconds / static_cast<double>(cache_count) * 1e9; };
+        std::printf("ns per sample, Phong diffuse + specular for 16K points:\n\n");
+        std::printf("| Vector       | UnitVector   |\n");
+        std::printf("|--------------|--------------|\n");
+        std::printf("| %-12.2f | %-12.2f |\n", ns(plain), ns(typed));
+    }
+} // namespace Bench
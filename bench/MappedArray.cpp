@@ -0,0 +1,64 @@
+// Thread scaling of a streaming kernel over std::vector and MappedArray storage.
+
+#include <cstdio>
+#include <span>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/MappedArray.h"
+#include "../source/Vector.h"
+
+namespace Bench {
+    namespace {
+        using V = Geometry::Vector3f;
+
+        /// v = v * 0.5 + 1 over [begin, end): one read and one write per element.
+        void stream(std::span<V> v, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                v[i] = v[i] * 0.5f + V(1.0f, 1.0f, 1.0f);
+            }
+        }
+
+        /// GB/s of reads + writes for `pass` over `memory_count` elements.
+        template<typename Pass>
+        double gb_per_s(Pass &&pass) {
+            const auto seconds = best_time(pass, 1, 5);
+            return 2.0 * static_cast<double>(memory_count * sizeof(V)) / seconds * 1e-9;
+        }
+
+        void measure(unsigned int threads) {
+            std::vector<V> vector(memory_count);
+            const auto plain = gb_per_s([&] {
+                Geometry::parallel_for(memory_count, [&](std::size_t begin, std::size_t end, unsigned int) {
+                    stream(vector, begin, end);
+                }, threads);
+                keep(vector.data());
+            });
+
+            const auto mapped = [threads](bool interleave) {
+                Geometry::MappedArray<V> array(memory_count, {.huge_pages = true, .interleave_nodes = interleave,
+                                                              .threads = threads});
+                return gb_per_s([&] {
+                    Geometry::pinned_parallel_for(array.size(), [&](std::size_t begin, std::size_t end, unsigned int) {
+                        stream(array.span(), begin, end);
+                    }, array.threads());
+                    keep(array.data());
+                });
+            };
+            std::printf("| %-7u | %-11.1f | %-23.1f | %-25.1f |\n", threads, plain, mapped(false), mapped(true));
+        }
+    } // namespace
+
+    void mapped_array() {
+        std::printf("GB/s of v = v * 0.5 + 1 over 16M Vector3f (192 MB); std::vector is filled by the"
+                    " calling thread and processed with parallel_for, MappedArray (huge pages) is first"
+                    " touched and processed with pinned_parallel_for:\n\n");
+        std::printf("| Threads | std::vector | MappedArray first touch | MappedArray interleaved   |\n");
+        std::printf("|---------|-------------|-------------------------|---------------------------|\n");
+        const auto most = Geometry::default_thread_count();
+        for (unsigned int threads = 1; threads < most; threads *= 2) {
+            measure(threads);
+        }
+        measure(most);
+    }
+} // namespace Bench
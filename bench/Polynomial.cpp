@@ -0,0 +1,117 @@
+// Batched cubic / quartic solvers of Polynomial.h against a loop over the scalar solvers.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/Polynomial.h"
+
+namespace Bench {
+    namespace {
+        /// Monic polynomials with Degree real roots in [-10, 10] at least 0.5 apart, the set
+        /// the accuracy figures of Polynomial.h are measured on.
+        template<std::size_t Degree, typename T>
+        struct Problems {
+            std::vector<std::vector<T>> coefficients;
+            std::vector<std::array<double, Degree>> roots;
+
+            explicit Problems(std::size_t count) : coefficients(Degree + 1, std::vector<T>(count)), roots(count) {
+                std::mt19937 engine(7);
+                std::uniform_real_distribution<double> position(-10.0, 10.0);
+                for (std::size_t i = 0; i < count; ++i) {
+                    auto &r = roots[i];
+                    do {
+                        for (auto &x: r) {
+                            x = position(engine);
+                        }
+                        std::sort(r.begin(), r.end());
+                    } while (std::adjacent_find(r.begin(), r.end(), [](double a, double b) {
+                        return b - a < 0.5;
+                    }) != r.end());
+                    std::array<double, Degree + 1> c{1.0};
+                    for (std::size_t k = 0; k < Degree; ++k) {
+                        for (auto j = k + 1; j > 0; --j) {
+                            c[j] -= c[j - 1] * r[k];
+                        }
+                    }
+                    for (std::size_t k = 0; k <= Degree; ++k) {
+                        coefficients[k][i] = static_cast<T>(c[k]);
+                    }
+                }
+            }
+        };
+
+        template<std::size_t Degree, typename T>
+        void measure(const char *name) {
+            constexpr std::size_t count = 1 << 16;
+            const Problems<Degree, T> problems(count);
+            std::array<std::span<const T>, Degree + 1> in;
+            for (std::size_t k = 0; k <= Degree; ++k) {
+                in[k] = problems.coefficients[k];
+            }
+            std::vector<std::vector<T>> roots(Degree, std::vector<T>(count));
+            std::array<std::span<T>, Degree> out;
+            for (std::size_t k = 0; k < Degree; ++k) {
+                out[k] = roots[k];
+            }
+            std::vector<std::uint8_t> counts(count);
+            const Geometry::SoASpan<Degree + 1, const T> coefficients(in);
+            const Geometry::SoASpan<Degree, T> soa_roots(out);
+
+            const auto reps = repetitions(count, std::size_t{1} << 20);
+            const auto batched = best_time([&] {
+                if constexpr (Degree == 3) {
+                    Geometry::solve_cubics(coefficients, soa_roots, counts);
+                } else {
+                    Geometry::solve_quartics(coefficients, soa_roots, counts);
+                }
+                keep(counts.data());
+            }, reps);
+            const auto scalar = best_time([&] {
+                for (std::size_t i = 0; i < count; ++i) {
+                    const auto k = coefficients.load(i);
+                    if constexpr (Degree == 3) {
+                        counts[i] = static_cast<std::uint8_t>(Geometry::solve_cubic(k[0], k[1], k[2], k[3]).count);
+                    } else {
+                        counts[i] = static_cast<std::uint8_t>(
+                                Geometry::solve_quartic(k[0], k[1], k[2], k[3], k[4]).count);
+                    }
+                }
+                keep(counts.data());
+            }, reps);
+
+            if constexpr (Degree == 3) {
+                Geometry::solve_cubics(coefficients, soa_roots, counts);
+            } else {
+                Geometry::solve_quartics(coefficients, soa_roots, counts);
+            }
+            double error = 0.0;
+            std::size_t wrong_count = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                wrong_count += counts[i] != Degree;
+                for (std::size_t k = 0; k < Degree && counts[i] == Degree; ++k) {
+                    const auto exact = problems.roots[i][k];
+                    error = std::max(error, std::abs(static_cast<double>(roots[k][i]) - exact) / (1.0 + std::abs(exact)));
+                }
+            }
+            std::printf("| %-15s | %-10.1f | %-14.1f | %-9.2g | %-11zu |\n", name, batched / count * 1e9,
+                        scalar / count * 1e9, error, wrong_count);
+        }
+    } // namespace
+
+    void polynomial() {
+        std::printf("ns per polynomial, 64K polynomials, one thread:\n\n");
+        std::printf("| Solver          | Batched    | Scalar solver  | Max error | Wrong count |\n");
+        std::printf("|-----------------|------------|----------------|-----------|-------------|\n");
+        measure<3, float>("cubic, float");
+        measure<3, double>("cubic, double");
+        measure<4, float>("quartic, float");
+        measure<4, double>("quartic, double");
+    }
+} // namespace Bench
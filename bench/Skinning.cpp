@@ -0,0 +1,86 @@
+// Vertex throughput of the skinning kernels of Skinning.h.
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/Skinning.h"
+
+namespace Bench {
+    void skinning() {
+        using V = Geometry::Vector3f;
+        constexpr std::size_t vertices = std::size_t{1} << 20;
+        constexpr std::size_t bone_count = 64;
+        std::mt19937 engine(11);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f), weight(0.0f, 1.0f);
+        std::uniform_int_distribution<std::uint16_t> bone(0, bone_count - 1);
+
+        std::vector<Geometry::Transform3f> bones(bone_count);
+        for (auto &b: bones) {
+            b = Geometry::Transform3f(
+                Geometry::Quaternion<float>::from_axis_angle(V(unit(engine), unit(engine), 1.0f), unit(engine)),
+                V(unit(engine), unit(engine), unit(engine)));
+        }
+        std::vector<Geometry::DualQuaternionf> dual_quaternions(bone_count);
+        Geometry::to_dual_quaternions(std::span<const Geometry::Transform3f>(bones),
+                                      std::span<Geometry::DualQuaternionf>(dual_quaternions));
+
+        std::array<std::vector<std::uint16_t>, Geometry::max_skin_influences> bone_indices;
+        std::array<std::vector<float>, Geometry::max_skin_influences> bone_weights;
+        Geometry::SkinWeights<float> influences;
+        for (std::size_t k = 0; k < Geometry::max_skin_influences; ++k) {
+            bone_indices[k].resize(vertices);
+            bone_weights[k].resize(vertices);
+        }
+        Geometry::SoAArray<3, float> positions(vertices), normals(vertices), out_positions(vertices),
+                out_normals(vertices);
+        for (std::size_t v = 0; v < vertices; ++v) {
+            float total = 0.0f;
+            for (std::size_t k = 0; k < Geometry::max_skin_influences; ++k) {
+                bone_indices[k][v] = bone(engine);
+                bone_weights[k][v] = weight(engine);
+                total += bone_weights[k][v];
+            }
+            for (std::size_t k = 0; k < Geometry::max_skin_influences; ++k) {
+                bone_weights[k][v] /= total;
+            }
+            positions.span().store(v, V(unit(engine), unit(engine), unit(engine)));
+            normals.span().store(v, V(unit(engine), unit(engine), 1.0f).normalized());
+        }
+        for (std::size_t k = 0; k < Geometry::max_skin_influences; ++k) {
+            influences.bones[k] = bone_indices[k];
+            influences.weights[k] = bone_weights[k];
+        }
+
+        const auto &rest_positions = positions, &rest_normals = normals;
+        const auto reps = repetitions(vertices, std::size_t{1} << 22);
+        const auto mvertices_per_s = [](double seconds) { return static_cast<double>(vertices) / seconds * 1e-6; };
+        const auto measure = [&](unsigned int threads) {
+            const auto linear = best_time([&] {
+                Geometry::skin_linear(std::span<const Geometry::Transform3f>(bones), influences, rest_positions.span(),
+                                      out_positions.span(), rest_normals.span(), out_normals.span(), threads);
+                keep(out_positions.span().component(0).data());
+            }, reps);
+            const auto dual = best_time([&] {
+                Geometry::skin_dual_quaternion(std::span<const Geometry::DualQuaternionf>(dual_quaternions), influences,
+                                               rest_positions.span(), out_positions.span(), rest_normals.span(),
+                                               out_normals.span(), threads);
+                keep(out_positions.span().component(0).data());
+            }, reps);
+            std::printf("| %-7u | %-12.0f | %-15.0f |\n", threads, mvertices_per_s(linear), mvertices_per_s(dual));
+        };
+
+        std::printf("Million vertices per second, positions and normals, 1M vertices, 4 influences from %zu"
+                    " bones:\n\n", bone_count);
+        std::printf("| Threads | Linear blend | Dual quaternion |\n");
+        std::printf("|---------|--------------|-----------------|\n");
+        measure(1);
+        if (Geometry::default_thread_count() > 1) {
+            measure(Geometry::default_thread_count());
+        }
+    }
+} // namespace Bench
@@ -0,0 +1,71 @@
+// Encode / decode throughput and compression ratio of Snapshot.h.
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/Snapshot.h"
+
+namespace Bench {
+    void snapshot() {
+        // Synthetic particles drifting inside a 200 m box, about 1 cm per tick on each axis:
+        // the quantization step is 3 mm, so deltas need 2 to 4 bits before zigzag.
+        constexpr std::size_t particles = 100'000;
+        constexpr std::size_t ticks = 32;
+        std::mt19937 engine(1);
+        std::uniform_real_distribution<float> box(-100.0f, 100.0f), drift(-0.01f, 0.01f);
+        std::vector<std::vector<Geometry::Vector3f>> frames(ticks, std::vector<Geometry::Vector3f>(particles));
+        for (auto &p: frames[0]) {
+            p = Geometry::Vector3f(box(engine), box(engine), box(engine));
+        }
+        std::vector<Geometry::Vector3f> velocities(particles);
+        for (auto &v: velocities) {
+            v = Geometry::Vector3f(drift(engine), drift(engine), drift(engine));
+        }
+        for (std::size_t t = 1; t < ticks; ++t) {
+            for (std::size_t i = 0; i < particles; ++i) {
+                frames[t][i] = frames[t - 1][i] + velocities[i];
+            }
+        }
+
+        const Geometry::PositionQuantizer<float> quantizer(Geometry::Vector3f(-110.0f, -110.0f, -110.0f),
+                                                           Geometry::Vector3f(110.0f, 110.0f, 110.0f));
+        Geometry::SnapshotEncoder encoder(quantizer);
+        Geometry::SnapshotDecoder decoder(quantizer);
+        std::vector<std::uint8_t> stream;
+        std::vector<std::size_t> offsets;
+        const auto encode_all = [&] {
+            encoder.reset();
+            stream.clear();
+            offsets.clear();
+            for (const auto &frame: frames) {
+                offsets.push_back(stream.size());
+                encoder.encode(std::span<const Geometry::Vector3f>(frame), stream);
+            }
+            keep(stream.data());
+        };
+        std::vector<Geometry::Vector3f> received;
+        const auto decode_all = [&] {
+            decoder.reset();
+            for (const auto offset: offsets) {
+                decoder.decode(std::span<const std::uint8_t>(stream).subspan(offset), received);
+            }
+            keep(received.data());
+        };
+
+        const auto raw_bytes = static_cast<double>(ticks * particles * sizeof(Geometry::Vector3f));
+        const auto encode_time = best_time(encode_all, 1, 5);
+        const auto decode_time = best_time(decode_all, 1, 5);
+        const auto key_frame_bytes = static_cast<double>(offsets[1]);
+        const auto delta_bytes = static_cast<double>(stream.size()) - key_frame_bytes;
+        std::printf("%zu particles, %zu ticks, MB/s of raw Vector3f positions:\n\n", particles, ticks);
+        std::printf("| Encode MB/s | Decode MB/s | Key frame ratio | Delta frame ratio |\n");
+        std::printf("|-------------|-------------|-----------------|-------------------|\n");
+        std::printf("| %-11.0f | %-11.0f | %-15.1f | %-17.1f |\n", raw_bytes / encode_time * 1e-6,
+                    raw_bytes / decode_time * 1e-6, raw_bytes / static_cast<double>(ticks) / key_frame_bytes,
+                    raw_bytes * static_cast<double>(ticks - 1) / static_cast<double>(ticks) / delta_bytes);
+    }
+} // namespace Bench
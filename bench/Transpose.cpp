@@ -0,0 +1,95 @@
+// AoS <-> SoA conversion throughput of Transpose.h.
+
+#include <cstdio>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/SoA.h"
+#include "../source/Transpose.h"
+
+namespace Bench {
+    namespace {
+        using V = Geometry::Vector3f;
+
+        struct Throughput {
+            double loop;
+            double shuffles;
+            double non_temporal;
+        };
+
+        /// GB/s of input + output for both directions, plain loop against the shuffle kernels.
+        std::pair<Throughput, Throughput> measure(std::size_t n) {
+            std::vector<V> aos(n), back(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                aos[i] = V(static_cast<float>(i), static_cast<float>(i + 1), static_cast<float>(i + 2));
+            }
+            Geometry::SoAArray<3, float> soa(n);
+            const auto lanes = soa.span();
+            const auto x = lanes.component(0), y = lanes.component(1), z = lanes.component(2);
+            const std::span<const V> in(aos);
+            const std::span<V> out(back);
+            const auto reps = repetitions(n);
+            const auto gb_per_s = [n](double seconds) {
+                return 2.0 * static_cast<double>(n * sizeof(V)) / seconds * 1e-9;
+            };
+
+            Throughput to_soa{}, to_aos{};
+            to_soa.loop = gb_per_s(best_time([&] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    x[i] = in[i][0];
+                    y[i] = in[i][1];
+                    z[i] = in[i][2];
+                }
+                keep(x.data());
+            }, reps));
+            to_soa.shuffles = gb_per_s(best_time([&] {
+                Geometry::aos_to_soa(in, lanes);
+                keep(x.data());
+            }, reps));
+            to_soa.non_temporal = gb_per_s(best_time([&] {
+                Geometry::aos_to_soa<Geometry::StorePolicy::NonTemporal>(in, lanes);
+                keep(x.data());
+            }, reps));
+
+            const auto const_lanes = std::as_const(soa).span();
+            to_aos.loop = gb_per_s(best_time([&] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    out[i] = V(x[i], y[i], z[i]);
+                }
+                keep(out.data());
+            }, reps));
+            to_aos.shuffles = gb_per_s(best_time([&] {
+                Geometry::soa_to_aos(const_lanes, out);
+                keep(out.data());
+            }, reps));
+            to_aos.non_temporal = gb_per_s(best_time([&] {
+                Geometry::soa_to_aos<Geometry::StorePolicy::NonTemporal>(const_lanes, out);
+                keep(out.data());
+            }, reps));
+            return {to_soa, to_aos};
+        }
+    } // namespace
+
+    void transpose() {
+#if defined(__AVX__)
+        constexpr const char *isa = "AVX";
+#else
+        constexpr const char *isa = "SSE2";
+#endif
+        std::printf("GB/s of input + output moved for Vector3f, %s build:\n\n", isa);
+        std::printf("| Conversion      | Size       | Loop  | Shuffles | Shuffles, non-temporal |\n");
+        std::printf("|-----------------|------------|-------|----------|------------------------|\n");
+        for (const auto n: {cache_count, memory_count}) {
+            const auto [to_soa, to_aos] = measure(n);
+            const auto large = n >= memory_count;
+            const auto size = large ? n >> 20 : n >> 10;
+            const auto *unit = large ? "M (DRAM)" : "K (L2)  ";
+            std::printf("| Vector3f -> SoA | %3zu%s | %-5.1f | %-8.1f | %-22.1f |\n", size, unit, to_soa.loop,
+                        to_soa.shuffles, to_soa.non_temporal);
+            std::printf("| SoA -> Vector3f | %3zu%s | %-5.1f | %-8.1f | %-22.1f |\n", size, unit, to_aos.loop,
+                        to_aos.shuffles, to_aos.non_temporal);
+        }
+    }
+} // namespace Bench
@@ -0,0 +1,70 @@
+// Element loop, chunked loop and eager evaluation of a VectorViews.h pipeline.
+
+#include <cstdio>
+#include <span>
+#include <vector>
+
+#include "Bench.h"
+#include "../source/Quaternion.h"
+#include "../source/Transform3.h"
+#include "../source/VectorAlgorithms.h"
+#include "../source/VectorViews.h"
+
+namespace Bench {
+    namespace {
+        using V = Geometry::Vector3f;
+
+        void measure(const char *build, const char *size, std::size_t n) {
+            std::vector<V> source(n), result(n), temporary(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                source[i] = V(static_cast<float>(i % 97) + 1.0f, static_cast<float>(i % 89), static_cast<float>(i % 83));
+            }
+            const auto model = Geometry::Transform3f(Geometry::Quaternion<float>::from_axis_angle(V(0.0f, 0.0f, 1.0f), 0.5f),
+                                                     V(1.0f, 2.0f, 3.0f));
+            const V axis(1.0f, 1.0f, 0.0f);
+            const auto squared = axis.squared_mag();
+            const std::span<const V> in(source);
+            const std::span<V> out(result), tmp(temporary);
+            const auto view = in | Geometry::views::transform_points(model) | Geometry::views::normalized
+                              | Geometry::views::project_onto(axis);
+            const auto &pipeline = view.pipeline();
+            const auto reps = repetitions(n);
+
+            const auto element = best_time([&] {
+                for (std::size_t i = 0; i < n; ++i) {
+                    out[i] = pipeline(in[i]);
+                }
+                keep(out.data());
+            }, reps);
+            const auto chunked = best_time([&] {
+                Geometry::detail::run_pipeline_chunks(pipeline, in, out);
+                keep(out.data());
+            }, reps);
+            const auto eager = best_time([&] {
+                model.transform_points(in, tmp);
+                Geometry::normalize(std::span<const V>(tmp), tmp);
+                Geometry::transform(std::span<const V>(tmp), out, [&](const V &v) {
+                    return axis * (v.dot(axis) / squared);
+                });
+                keep(out.data());
+            }, reps);
+            const auto ns = [n](double seconds) { return seconds / static_cast<double>(n) * 1e9; };
+            std::printf("| %-21s | %-10s | %-12.1f | %-12.1f | %-5.1f |\n", build, size, ns(element), ns(chunked), ns(eager));
+        }
+    } // namespace
+
+    void views() {
+#if defined(__AVX2__)
+        const char *build = "-march=native (AVX2)";
+#else
+        const char *build = "SSE2 (default)";
+#endif
+        std::printf("ns per element, transform_points | normalized | project_onto, one thread"
+                    " (materialize runs the %s loop in this build):\n\n",
+                    Geometry::pipeline_chunked ? "chunked" : "element");
+        std::printf("| Build                 | Size       | Element loop | Chunked loop | Eager |\n");
+        std::printf("|-----------------------|------------|--------------|--------------|-------|\n");
+        measure(build, "16K (L2)", cache_count);
+        measure(build, "16M (DRAM)", memory_count);
+    }
+} // namespace Bench
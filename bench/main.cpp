@@ -0,0 +1,30 @@
+#include <cstdio>
+#include <string_view>
+
+#include "Bench.h"
+
+int main(int argc, char **argv) {
+    int status = 0;
+    for (const auto &entry: Bench::benchmarks) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i) {
+            selected = selected || entry.name == argv[i];
+        }
+        if (selected) {
+            std::printf("== %.*s\n", static_cast<int>(entry.name.size()), entry.name.data());
+            entry.run();
+            std::printf("\n");
+        }
+    }
+    for (int i = 1; i < argc; ++i) {
+        bool known = false;
+        for (const auto &entry: Bench::benchmarks) {
+            known = known || entry.name == argv[i];
+        }
+        if (!known) {
+            std::fprintf(stderr, "Unknown benchmark: %s\n", argv[i]);
+            status = 1;
+        }
+    }
+    return status;
+}
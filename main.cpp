@@ -1,6 +1,48 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <tuple>
 
 #include "source/Vector.h"
+#include "source/Accumulate.h"
+#include "source/Task.h"
+#include "source/Gather.h"
+#include "source/MappedArray.h"
+#include "source/Quantize.h"
+#include "source/Snapshot.h"
+#include "source/SharedRing.h"
+#include "source/Transform3.h"
+#include "source/TransformHierarchy.h"
+#include "source/Skinning.h"
+#include "source/Culling.h"
+#include "source/Curves.h"
+#include "source/Polynomial.h"
+#include "source/Random.h"
+#include "source/PoissonDisk.h"
+#include "source/VectorBatch.h"
+#include "source/FastMath.h"
+#include "source/Point.h"
+#include "source/VectorBlockArray.h"
+#include "source/Transpose.h"
+#include "source/VectorViews.h"
+#include "source/VectorAlgorithms.h"
+
+Geometry::Task<float> sum_of_magnitudes(Geometry::ThreadPool &pool, std::vector<Geometry::Vector3f> &points) {
+    std::vector<float> partial(pool.size(), 0.0f);
+    co_await Geometry::parallel_batch(pool, points.size(), [&](std::size_t begin, std::size_t end, unsigned int chunk) {
+        for (auto i = begin; i < end; ++i) {
+            partial[chunk] += points[i].magnitude();
+        }
+    });
+    float sum = 0.0f;
+    for (const auto p: partial) {
+        sum += p;
+    }
+    co_return sum;
+}
 
 constexpr bool test_vector_access() {
     Geometry::Vector<3, int> v(10, 20, 30);
@@ -13,6 +55,120 @@ constexpr auto mutability_test() {
     return v[0];
 }
 
+// Largest error of `fn` against the long double libm `reference` over `samples` arguments drawn
+// by `draw`, in ulp of the correctly rounded result, or absolute when `absolute` is set.
+template<typename T, typename Draw, typename Fn, typename Reference>
+double max_error(Draw draw, Fn fn, Reference reference, bool absolute = false, int samples = 1 << 18) {
+    std::mt19937_64 rng(7);
+    double worst = 0.0;
+    for (int i = 0; i < samples; ++i) {
+        const auto args = draw(rng);
+        const long double exact = std::apply(reference, args);
+        const auto rounded = static_cast<T>(exact);
+        const auto ulp = std::nextafter(std::abs(rounded), std::numeric_limits<T>::infinity()) - std::abs(rounded);
+        const auto error = std::abs(static_cast<long double>(std::apply(fn, args)) - exact);
+        worst = std::max(worst, static_cast<double>(absolute ? error : error / ulp));
+    }
+    return worst;
+}
+
+// Checks the error table of FastMath.h for one type and accuracy tier.
+template<typename T, Geometry::MathAccuracy Accuracy>
+bool check_fastmath_bounds() {
+    namespace fm = Geometry::fastmath;
+    constexpr bool is_float = std::is_same_v<T, float>;
+    constexpr bool fast_float = is_float && Accuracy == Geometry::MathAccuracy::Fast;
+    const auto uniform = [](T lo, T hi) {
+        return [=](std::mt19937_64 &rng) { return std::tuple{std::uniform_real_distribution<T>(lo, hi)(rng)}; };
+    };
+    // Magnitudes spread over many binades, both signs.
+    const auto spread = [](std::mt19937_64 &rng) {
+        const auto m = std::uniform_real_distribution<T>(-1, 1)(rng);
+        return std::ldexp(m, std::uniform_int_distribution<int>(-30, 30)(rng));
+    };
+    const T trig_range = Accuracy == Geometry::MathAccuracy::Fast ? T(1e4) : T(1e6);
+    // Beyond the Cody-Waite range up to the largest finite T, where Precise hands over to libm.
+    const auto huge = [](std::mt19937_64 &rng) {
+        const auto m = std::uniform_real_distribution<T>(-1, 1)(rng);
+        return std::tuple{std::ldexp(m, std::uniform_int_distribution<int>(21, std::numeric_limits<T>::max_exponent)(rng))};
+    };
+    // The span forms, which check their arguments block by block.
+    const auto span_form = [](auto fn) {
+        return [fn](T x) {
+            T y;
+            fn(std::span<const T>(&x, 1), std::span<T>(&y, 1));
+            return y;
+        };
+    };
+    constexpr bool precise = Accuracy == Geometry::MathAccuracy::Precise;
+    // Fast exp builds 2^n from bits, so its results stop at 2^(max_exponent - 0.5).
+    const T exp_lo = std::log(std::numeric_limits<T>::min());
+    const T exp_hi = Accuracy == Geometry::MathAccuracy::Fast
+                             ? T((std::numeric_limits<T>::max_exponent - 0.51) * std::numbers::ln2)
+                             : std::log(std::numeric_limits<T>::max());
+
+    struct Row {
+        const char *name;
+        double error, bound;
+    };
+    const Row rows[] = {
+        {"sin", max_error<T>(uniform(-trig_range, trig_range), [](T x) { return fm::sin<Accuracy>(x); },
+                             [](T x) { return std::sin(static_cast<long double>(x)); }, fast_float),
+         fast_float ? 1.6e-7 : 1.6},
+        {"cos", max_error<T>(uniform(-trig_range, trig_range), [](T x) { return fm::cos<Accuracy>(x); },
+                             [](T x) { return std::cos(static_cast<long double>(x)); }, fast_float),
+         fast_float ? 1.6e-7 : 1.6},
+        {"sin of huge x", precise ? max_error<T>(huge, span_form([](auto in, auto out) { fm::sin<Accuracy>(in, out); }),
+                                                 [](T x) { return std::sin(static_cast<long double>(x)); }) : 0.0,
+         1.6},
+        {"cos of huge x", precise ? max_error<T>(huge, span_form([](auto in, auto out) { fm::cos<Accuracy>(in, out); }),
+                                                 [](T x) { return std::cos(static_cast<long double>(x)); }) : 0.0,
+         1.6},
+        {"atan2", max_error<T>([&](std::mt19937_64 &rng) { return std::tuple{spread(rng), spread(rng)}; },
+                               [](T y, T x) { return fm::atan2<Accuracy>(y, x); },
+                               [](T y, T x) {
+                                   return std::atan2(static_cast<long double>(y), static_cast<long double>(x));
+                               }),
+         fast_float ? 3.2 : 3.0},
+        {"acos", max_error<T>(uniform(-1, 1), [](T x) { return fm::acos<Accuracy>(x); },
+                              [](T x) { return std::acos(static_cast<long double>(x)); }),
+         is_float ? 1.3 : 3.4},
+        {"exp", max_error<T>(uniform(exp_lo, exp_hi), [](T x) { return fm::exp<Accuracy>(x); },
+                             [](T x) { return std::exp(static_cast<long double>(x)); }),
+         1.3},
+        {"log", max_error<T>([](std::mt19937_64 &rng) {
+                                 const auto m = std::uniform_real_distribution<T>(1, 2)(rng);
+                                 const auto e = std::uniform_int_distribution<int>(
+                                         std::numeric_limits<T>::min_exponent - 1,
+                                         std::numeric_limits<T>::max_exponent - 1)(rng);
+                                 return std::tuple{std::ldexp(m, e)};
+                             },
+                             [](T x) { return fm::log<Accuracy>(x); },
+                             [](T x) { return std::log(static_cast<long double>(x)); }),
+         0.8},
+    };
+    bool ok = true;
+    // sin(-0) = -0 in the scalar, span and sincos forms.
+    const T negative_zero = -T(0);
+    T span_sin, sincos_sin, sincos_cos;
+    fm::sin<Accuracy>(std::span<const T>(&negative_zero, 1), std::span<T>(&span_sin, 1));
+    fm::sincos<Accuracy>(negative_zero, sincos_sin, sincos_cos);
+    if (!std::signbit(fm::sin<Accuracy>(negative_zero)) || !std::signbit(span_sin) || !std::signbit(sincos_sin)) {
+        std::cout << "fastmath::sin" << (is_float ? " float" : " double") << (precise ? " precise" : " fast")
+                  << ": sin(-0) is not -0" << std::endl;
+        ok = false;
+    }
+    for (const auto &row: rows) {
+        if (row.error > row.bound) {
+            std::cout << "fastmath::" << row.name << (is_float ? " float" : " double")
+                      << (Accuracy == Geometry::MathAccuracy::Fast ? " fast" : " precise") << ": error " << row.error
+                      << " above " << row.bound << std::endl;
+            ok = false;
+        }
+    }
+    return ok;
+}
+
 int main()
 {
     static_assert(Geometry::Vector<3, double>::dim() == 3);
@@ -58,5 +214,214 @@ int main()
     const Geometry::Vector3 vec_proj2(3.0, 1.0, 2.0);
     std::cout << "Vec_proj: : " << vec_proj1.project(vec_proj2) << std::endl;
 
+    // Scatter-add two springs sharing node 1 with every accumulation policy.
+    const std::vector<std::uint32_t> spring_nodes{0, 1, 1, 2};
+    const std::vector<Geometry::Vector3f> spring_forces{
+        Geometry::Vector3f(1.0f, 0.0f, 0.0f), Geometry::Vector3f(-1.0f, 0.0f, 0.0f),
+        Geometry::Vector3f(0.0f, 2.0f, 0.0f), Geometry::Vector3f(0.0f, -2.0f, 0.0f)
+    };
+    for (const auto policy: {Geometry::AccumulatePolicy::Atomic,
+                             Geometry::AccumulatePolicy::Privatized,
+                             Geometry::AccumulatePolicy::Colored}) {
+        std::vector<Geometry::Vector3f> forces(3);
+        Geometry::scatter_add(std::span(forces), std::span(spring_nodes), std::span(spring_forces), policy, 2);
+        std::cout << "Scatter-add: " << forces[0] << ' ' << forces[1] << ' ' << forces[2] << std::endl;
+    }
+
+    // Gather spring endpoints into SoA lanes.
+    Geometry::SoAArray<3, float> endpoints(spring_nodes.size());
+    Geometry::gather(std::span<const Geometry::Vector3f>(spring_forces), std::span(spring_nodes), endpoints.span());
+    std::cout << "Gathered: " << endpoints.span().load(1) << ' ' << endpoints.span().load(3) << std::endl;
+
+    // Huge-page backed array, first touched on the CPUs of the pinned workers that normalize it.
+    Geometry::MappedArray<Geometry::Vector3f> normals(1 << 16, {.threads = 2});
+    Geometry::pinned_parallel_for(normals.size(), [&](std::size_t begin, std::size_t end, unsigned int) {
+        for (auto i = begin; i < end; ++i) {
+            normals[i] = Geometry::Vector3f(3.0f, 0.0f, 4.0f).normalized();
+        }
+    }, normals.threads());
+    std::cout << "Mapped normals: " << normals.size() << " x " << normals[42] << std::endl;
+
+    // Compress a normal to 16 bits and a position to 6 bytes.
+    const auto normal = Geometry::Vector3f(1.0f, 2.0f, -2.0f).normalized();
+    const auto packed_normal = Geometry::encode_octahedral<16>(normal);
+    std::cout << "Octahedral 16: " << normal << " -> " << Geometry::decode_octahedral(packed_normal) << std::endl;
+    const Geometry::PositionQuantizer<float> quantizer(Geometry::Vector3f(-100.0f), Geometry::Vector3f(100.0f));
+    std::cout << "Quantized position: " << quantizer.decode(quantizer.encode(vec4)) << " (max error "
+              << quantizer.max_error() << ')' << std::endl;
+
+    // Stream two ticks of positions: a key frame, then a small delta.
+    Geometry::SnapshotEncoder snapshot_encoder(quantizer);
+    Geometry::SnapshotDecoder snapshot_decoder(quantizer);
+    std::vector<Geometry::Vector3f> particles(256, Geometry::Vector3f(10.0f, -20.0f, 30.0f));
+    std::vector<Geometry::Vector3f> received;
+    for (int tick = 0; tick < 2; ++tick) {
+        std::vector<std::uint8_t> packet;
+        snapshot_encoder.encode(particles, packet);
+        snapshot_decoder.decode(packet, received);
+        std::cout << "Snapshot tick " << tick << ": " << packet.size() << " bytes, " << received[0] << std::endl;
+        for (auto &p: particles) {
+            p = p + Geometry::Vector3f(0.01f, 0.0f, 0.0f);
+        }
+    }
+
+    // Publish a frame through shared memory and read it back in place.
+    auto producer = Geometry::SharedVectorRing<3, float>::create("/maths_cpp_demo", Geometry::VectorLayout::AoS, 16);
+    const auto frame_out = producer.write_aos();
+    frame_out[0] = vec4;
+    producer.publish(1);
+    const auto consumer = Geometry::SharedVectorRing<3, float>::open("/maths_cpp_demo");
+    if (const auto frame = consumer.acquire_latest(); frame && consumer.still_valid(*frame)) {
+        std::cout << "Shared frame " << frame->number << ": " << consumer.aos(*frame)[0] << std::endl;
+    }
+
+    // Compose rigid transforms and undo them with the cheap rigid inverse.
+    const auto quarter_turn = Geometry::Quaterniond::from_axis_angle(Geometry::Vector3(0.0, 0.0, 1.0), std::acos(0.0));
+    const Geometry::Transform3d body(quarter_turn, Geometry::Vector3(1.0, 0.0, 0.0));
+    const auto world = body * Geometry::Transform3d::from_translation(Geometry::Vector3(0.0, 2.0, 0.0));
+    std::cout << "Transformed: " << world.transform_point(vec1) << " back: "
+              << world.rigid_inverse().transform_point(world.transform_point(vec1)) << std::endl;
+
+    // Propagate a small arm hierarchy, then move the shoulder only.
+    Geometry::TransformHierarchy<double> arm;
+    const auto shoulder = arm.add_node(body);
+    const auto elbow = arm.add_node(Geometry::Transform3d::from_translation(Geometry::Vector3(0.0, 1.0, 0.0)), shoulder);
+    arm.update();
+    std::cout << "Elbow: " << arm.world(elbow).translation();
+    arm.set_local(shoulder, Geometry::Transform3d::identity());
+    arm.update();
+    std::cout << " -> " << arm.world(elbow).translation() << std::endl;
+
+    // Skin two vertices halfway between the shoulder and the elbow.
+    const std::array<Geometry::Transform3d, 2> skeleton{arm.world(shoulder), arm.world(elbow)};
+    std::array<Geometry::DualQuaterniond, 2> skeleton_dq;
+    Geometry::to_dual_quaternions<double>(skeleton, skeleton_dq);
+    const std::array<std::uint16_t, 2> first_bone{0, 0}, second_bone{1, 1};
+    const std::array<double, 2> half_weight{0.5, 0.5}, no_weight{0.0, 0.0};
+    const Geometry::SkinWeights<double> skin{{first_bone, second_bone, first_bone, first_bone},
+                                             {half_weight, half_weight, no_weight, no_weight}};
+    Geometry::SoAArray<3, double> rest(2), skinned(2);
+    rest.span().store(0, Geometry::Vector3(1.0, 0.0, 0.0));
+    rest.span().store(1, Geometry::Vector3(0.0, 0.0, 1.0));
+    Geometry::skin_dual_quaternion<double>(skeleton_dq, skin, rest.span(), skinned.span());
+    std::cout << "Skinned: " << skinned.span().load(0) << std::endl;
+
+    // Cull spheres against the unit clip cube (identity view-projection).
+    const auto view = Geometry::Frustum<double>::from_matrix(Geometry::Matrix4::identity());
+    const std::array<double, 3> sphere_x{0.0, 3.0, 1.2}, sphere_y{0.0, 0.0, 0.0}, sphere_z{0.0, 0.0, 0.0};
+    const std::array<double, 3> sphere_radii{0.5, 0.5, 0.5};
+    std::vector<std::uint32_t> visible_spheres;
+    Geometry::cull_spheres<double>(view, Geometry::SoASpan<3, const double>(sphere_x, sphere_y, sphere_z),
+                                   sphere_radii, visible_spheres);
+    std::cout << "Visible spheres: " << visible_spheres.size() << " of " << sphere_radii.size() << std::endl;
+
+    // Move at constant speed along a Catmull-Rom path.
+    const std::array<Geometry::Vector3, 4> waypoints{Geometry::Vector3(0.0, 0.0, 0.0), Geometry::Vector3(1.0, 0.0, 0.0),
+                                                     Geometry::Vector3(2.0, 1.0, 0.0), Geometry::Vector3(3.0, 1.0, 0.0)};
+    const auto path = Geometry::CubicCurve<3, double>::catmull_rom(waypoints);
+    const Geometry::ArcLengthTable<3, double> path_length(path);
+    std::cout << "Path length " << path_length.length() << ", halfway at "
+              << path.evaluate(path_length.parameter_at(path_length.length() * 0.5)) << std::endl;
+
+    // Solve (x - 1)(x - 2)(x - 3)(x - 4) = 0.
+    const auto quartic_roots = Geometry::solve_quartic(1.0, -10.0, 35.0, -50.0, 24.0);
+    std::cout << "Quartic roots:";
+    for (const auto root: quartic_roots.span()) {
+        std::cout << ' ' << root;
+    }
+    std::cout << std::endl;
+
+    // Emit particles in reproducible directions, whatever the thread count.
+    std::vector<Geometry::Vector3f> emission(1024);
+    Geometry::sample_sphere<float>(emission, 42, Geometry::SampleSequence::Sobol, 0, 4);
+    std::cout << "First emission direction: " << emission[1] << std::endl;
+
+    // Seed blue-noise particles in a 10x10 square.
+    const auto seeds = Geometry::poisson_disk_tiled<2, double>(Geometry::Vector2(0.0, 0.0), Geometry::Vector2(10.0, 10.0),
+                                                                0.5, 7, 2, 8);
+    std::cout << "Poisson-disk seeds: " << seeds.size() << std::endl;
+
+    // Branch-free bounding: clamp into a box and pick components with a mask.
+    const auto clamped = Geometry::clamp(vec1, Geometry::Vector3(0.0), Geometry::Vector3(2.0));
+    const auto mask = Geometry::greater(vec1, clamped);
+    std::cout << "Clamped: " << clamped << " mask " << mask << " any: " << Geometry::any(mask) << std::endl;
+
+    // Angles between pairs of unit vectors, computed as one vectorizable loop.
+    std::vector<float> cosines{1.0f, 0.5f, 0.0f, -1.0f}, angles(cosines.size());
+    Geometry::fastmath::acos<Geometry::MathAccuracy::Fast>(std::span<const float>(cosines), std::span<float>(angles));
+    std::cout << "Angles: " << angles[1] << " " << angles[3] << std::endl;
+
+    // The error bounds quoted in FastMath.h, against long double libm.
+    const bool fastmath_ok = check_fastmath_bounds<float, Geometry::MathAccuracy::Precise>()
+                             & check_fastmath_bounds<float, Geometry::MathAccuracy::Fast>()
+                             & check_fastmath_bounds<double, Geometry::MathAccuracy::Precise>()
+                             & check_fastmath_bounds<double, Geometry::MathAccuracy::Fast>();
+    std::cout << "Fast math within bounds: " << fastmath_ok << std::endl;
+    if (!fastmath_ok) {
+        return 1;
+    }
+
+    // Bounce a ray off the floor and bend it into water.
+    const Geometry::Vector3 ray(1.0, -1.0, 0.0);
+    const Geometry::UnitVector3 floor_normal = Geometry::Vector3(0.0, 1.0, 0.0).normalized();
+    std::cout << "Reflected: " << Geometry::reflect(ray, floor_normal)
+              << " refracted: " << Geometry::refract(ray.normalized(), floor_normal, 1.0 / 1.33)
+              << " angle: " << Geometry::angle_between(ray, floor_normal) << std::endl;
+
+    // Points pick up the translation of a transform, directions between them do not.
+    const Geometry::Point3 tip(1.0, 1.0, 0.0), base(1.0, 0.0, 0.0);
+    std::cout << "Moved tip: " << world.transform(tip) << " arm: " << world.transform(tip - base) << std::endl;
+
+    // 2D without promoting to 3D: winding of a triangle and a quarter turn as a complex product.
+    const Geometry::Vector2 corner_a(0.0, 0.0), corner_b(2.0, 0.0), corner_c(0.0, 1.0);
+    std::cout << "Orientation: " << Geometry::orientation(corner_a, corner_b, corner_c)
+              << " quarter turn: " << corner_b.rotated(corner_b.perp().normalized()) << std::endl;
+
+    // Blocked AoSoA storage: SIMD-friendly kernels, one or two cache lines per random access.
+    Geometry::Vector3fBlockArray velocities(10);
+    velocities.store(9, Geometry::Vector3f(0.0f, 3.0f, 4.0f));
+    Geometry::normalize(velocities, velocities);
+    std::cout << "Blocks: " << velocities.block_count() << " last: " << velocities.load(9) << std::endl;
+
+    // The elements are proxies, yet the standard algorithms permute them in place.
+    for (std::size_t i = 0; i < velocities.size(); ++i) {
+        velocities.store(i, Geometry::Vector3f(static_cast<float>((i * 7) % 10), 0.0f, 0.0f));
+    }
+    std::ranges::sort(velocities, {}, [](const Geometry::Vector3f &v) { return v[0]; });
+    const bool sorted = std::ranges::is_sorted(velocities, {}, [](const Geometry::Vector3f &v) { return v[0]; });
+    std::reverse(velocities.begin(), velocities.end());
+    std::cout << "Sorted: " << sorted << " reversed first: " << velocities.load(0) << std::endl;
+    if (!sorted || velocities.load(0)[0] != 9.0f) {
+        return 1;
+    }
+
+    // AoS <-> SoA with SIMD shuffles; streaming stores for arrays that outgrow the cache.
+    const std::vector<Geometry::Vector3f> samples(9, Geometry::Vector3f(1.0f, 2.0f, 3.0f));
+    Geometry::SoAArray<3, float> sample_lanes(samples.size());
+    Geometry::aos_to_soa(std::span<const Geometry::Vector3f>(samples), sample_lanes.span());
+    std::vector<Geometry::Vector3f> samples_back(samples.size());
+    Geometry::soa_to_aos<Geometry::StorePolicy::NonTemporal>(std::as_const(sample_lanes).span(),
+                                                             std::span<Geometry::Vector3f>(samples_back));
+    std::cout << "Transposed: " << sample_lanes.span().component(2)[8] << ' ' << samples_back[8] << std::endl;
+
+    // Lazy adaptor chain, evaluated as one chunked SoA loop when materialized.
+    const auto on_floor = samples | Geometry::views::scaled(2.0f) | Geometry::views::normalized
+                          | Geometry::views::project_onto(Geometry::Vector3f(1.0f, 0.0f, 0.0f));
+    std::cout << "Pipeline: " << on_floor[0] << ' ' << Geometry::to_vector(on_floor).back() << std::endl;
+
+    // Execution policies: the thread count follows the amount of work, so this runs inline.
+    std::vector<Geometry::Vector3f> headings(samples.begin(), samples.end());
+    Geometry::normalize(Geometry::execution::par, std::span<const Geometry::Vector3f>(headings),
+                        std::span<Geometry::Vector3f>(headings));
+    Geometry::sort_by_key(Geometry::execution::par, std::span<Geometry::Vector3f>(headings),
+                          [](const Geometry::Vector3f &h) { return h[2]; });
+    std::cout << "Heading sum: " << Geometry::reduce(Geometry::execution::par,
+                                                     std::span<const Geometry::Vector3f>(headings)) << std::endl;
+
+    // Run a batched job on the thread pool and wait for its result.
+    Geometry::ThreadPool pool(2);
+    std::vector<Geometry::Vector3f> unit_points(1000, Geometry::Vector3f(0.0f, 0.6f, 0.8f));
+    std::cout << "Sum of magnitudes: " << Geometry::sync_wait(sum_of_magnitudes(pool, unit_points)) << std::endl;
+
     return 0;
 }
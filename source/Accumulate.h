@@ -0,0 +1,189 @@
+/**
+ * @file Accumulate.h
+ * @brief Concurrent scatter-add of vector contributions into a shared vector array.
+ *
+ * Typical use is force accumulation: every spring or contact pair emits one contribution
+ * per endpoint, `targets[indices[i]] += values[i]`, and several contributions may hit the
+ * same target. Three strategies are provided, selected by `AccumulatePolicy`:
+ *  - Atomic: per-component CAS loops through `std::atomic_ref`; no extra memory, cost grows
+ *    with contention.
+ *  - Privatized: every thread accumulates into its own zeroed copy of the targets, then the
+ *    copies are merged in parallel; cost grows with the target count times the thread count.
+ *  - Colored: contributions are grouped into conflict-free colors (no two contributions of a
+ *    color share a target) and each color is applied in parallel without synchronization.
+ * `bench accumulate` compares the three against a serial loop at several contention levels.
+ * Requires C++20
+ */
+
+#ifndef ACCUMULATE_H
+#define ACCUMULATE_H
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Parallel.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /// @brief Strategy used by `scatter_add` to resolve write conflicts.
+    enum class AccumulatePolicy {
+        Atomic,
+        Privatized,
+        Colored
+    };
+
+    /**
+     * @brief Atomically add `value` to `target` with a compare-and-swap loop.
+     * @note `target` must satisfy `std::atomic_ref<T>::required_alignment`.
+     */
+    template<typename T>
+    void atomic_add(T &target, T value) {
+        std::atomic_ref<T> ref(target);
+        T expected = ref.load(std::memory_order_relaxed);
+        while (!ref.compare_exchange_weak(expected, expected + value, std::memory_order_relaxed)) {
+        }
+    }
+
+    /// @brief Atomically add `value` to every component of `target`.
+    template<unsigned int Dim, typename T>
+    void atomic_add(Vector<Dim, T> &target, const Vector<Dim, T> &value) {
+        for (auto i = 0u; i < Dim; ++i) {
+            atomic_add(target[i], value[i]);
+        }
+    }
+
+    /**
+     * @brief Conflict-free grouping of scatter contributions.
+     *
+     * `order` holds contribution indices sorted by color; color `c` spans
+     * [offsets[c], offsets[c + 1]). Within a color every target index appears at most once.
+     * A schedule only depends on the index list, so it can be built once and reused as long
+     * as the topology (springs, contact pairs) does not change.
+     */
+    struct ColorSchedule {
+        std::vector<std::uint32_t> order;
+        std::vector<std::size_t> offsets;
+
+        [[nodiscard]] std::size_t color_count() const {
+            return offsets.empty() ? 0 : offsets.size() - 1;
+        }
+
+        /**
+         * @brief Build the schedule for `indices` targeting an array of `target_count` elements.
+         *
+         * The k-th contribution to a given target gets color k, so the number of colors equals
+         * the highest number of contributions to a single target.
+         */
+        static ColorSchedule build(std::span<const std::uint32_t> indices, std::size_t target_count) {
+            std::vector<std::uint32_t> hits(target_count, 0);
+            std::vector<std::uint32_t> color(indices.size());
+            std::uint32_t color_count = 0;
+            for (std::size_t i = 0; i < indices.size(); ++i) {
+                assert(indices[i] < target_count && "Scatter index out of range.");
+                color[i] = hits[indices[i]]++;
+                color_count = std::max(color_count, color[i] + 1);
+            }
+
+            ColorSchedule schedule;
+            schedule.offsets.assign(color_count + 1, 0);
+            for (const auto c: color) {
+                ++schedule.offsets[c + 1];
+            }
+            for (std::size_t c = 0; c < color_count; ++c) {
+                schedule.offsets[c + 1] += schedule.offsets[c];
+            }
+            schedule.order.resize(indices.size());
+            auto cursor = schedule.offsets;
+            for (std::size_t i = 0; i < indices.size(); ++i) {
+                schedule.order[cursor[color[i]]++] = static_cast<std::uint32_t>(i);
+            }
+            return schedule;
+        }
+    };
+
+    /**
+     * @brief Apply a prebuilt color schedule: targets[indices[i]] += values[i].
+     * @param threads Number of threads used inside each color.
+     */
+    template<unsigned int Dim, typename T>
+    void scatter_add(std::span<Vector<Dim, T>> targets,
+                     std::span<const std::uint32_t> indices,
+                     std::span<const Vector<Dim, T>> values,
+                     const ColorSchedule &schedule,
+                     unsigned int threads = default_thread_count()) {
+        assert(indices.size() == values.size() && "One value is required per scatter index.");
+        assert(schedule.order.size() == indices.size() && "Schedule was built for another index list.");
+        for (std::size_t c = 0; c < schedule.color_count(); ++c) {
+            const auto first = schedule.offsets[c];
+            parallel_for(schedule.offsets[c + 1] - first, [&](std::size_t begin, std::size_t end, unsigned int) {
+                for (auto k = first + begin; k < first + end; ++k) {
+                    const auto i = schedule.order[k];
+                    targets[indices[i]] = targets[indices[i]] + values[i];
+                }
+            }, threads);
+        }
+    }
+
+    /**
+     * @brief Concurrent scatter-add: targets[indices[i]] += values[i] for every i.
+     *
+     * With `AccumulatePolicy::Colored` the schedule is rebuilt on every call; use the
+     * `ColorSchedule` overload to amortize it over several calls.
+     *
+     * @param policy Conflict resolution strategy.
+     * @param threads Number of worker threads.
+     */
+    template<unsigned int Dim, typename T>
+    void scatter_add(std::span<Vector<Dim, T>> targets,
+                     std::span<const std::uint32_t> indices,
+                     std::span<const Vector<Dim, T>> values,
+                     AccumulatePolicy policy,
+                     unsigned int threads = default_thread_count()) {
+        assert(indices.size() == values.size() && "One value is required per scatter index.");
+        switch (policy) {
+            case AccumulatePolicy::Atomic:
+                parallel_for(indices.size(), [&](std::size_t begin, std::size_t end, unsigned int) {
+                    for (auto i = begin; i < end; ++i) {
+                        assert(indices[i] < targets.size() && "Scatter index out of range.");
+                        atomic_add(targets[indices[i]], values[i]);
+                    }
+                }, threads);
+                break;
+
+            case AccumulatePolicy::Privatized: {
+                const auto chunks = std::max(1u, threads);
+                std::vector<std::vector<Vector<Dim, T>>> privates(chunks);
+                parallel_for(indices.size(), [&](std::size_t begin, std::size_t end, unsigned int t) {
+                    // Allocated by the thread that uses it.
+                    auto &local = privates[t];
+                    local.assign(targets.size(), Vector<Dim, T>());
+                    for (auto i = begin; i < end; ++i) {
+                        assert(indices[i] < targets.size() && "Scatter index out of range.");
+                        local[indices[i]] = local[indices[i]] + values[i];
+                    }
+                }, chunks);
+                parallel_for(targets.size(), [&](std::size_t begin, std::size_t end, unsigned int) {
+                    for (const auto &local: privates) {
+                        if (local.empty()) {
+                            continue;
+                        }
+                        for (auto j = begin; j < end; ++j) {
+                            targets[j] = targets[j] + local[j];
+                        }
+                    }
+                }, chunks);
+                break;
+            }
+
+            case AccumulatePolicy::Colored:
+                scatter_add(targets, indices, values, ColorSchedule::build(indices, targets.size()), threads);
+                break;
+        }
+    }
+} // namespace Geometry
+
+#endif // ACCUMULATE_H
@@ -0,0 +1,339 @@
+/**
+ * @file Culling.h
+ * @brief View-frustum culling of bounding spheres and AABBs, flat and hierarchical.
+ *
+ * Frustum planes are extracted from a view-projection matrix (Gribb-Hartmann) and
+ * normalized, so a plane (n, d) gives the signed distance n.p + d, positive inside.
+ *
+ * The batched kernels take SoA bounds and produce a compact list of visible indices.
+ * They work on blocks of `cull_block_size` elements: every plane is first tested against
+ * the whole block into a byte mask (a branch-free loop the compiler vectorizes across
+ * elements), then the mask is compacted into the output without branching.
+ *
+ * `cull_hierarchy` walks a caller-built bounding volume tree stored depth-first; subtrees
+ * fully inside a plane stop testing that plane, and subtrees fully inside the frustum
+ * are accepted without testing their objects. `bench culling` reports objects per
+ * microsecond for both.
+ * Requires C++20
+ */
+
+#ifndef CULLING_H
+#define CULLING_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Matrix.h"
+#include "Parallel.h"
+#include "SoA.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /// @brief Clip-space depth range of the projection matrix.
+    enum class ClipDepth {
+        NegativeOneToOne, ///< OpenGL convention: -w <= z <= w.
+        ZeroToOne ///< Direct3D / Vulkan convention: 0 <= z <= w.
+    };
+
+    /// @brief Elements tested per block by the batched kernels.
+    inline constexpr std::size_t cull_block_size = 64;
+
+    /**
+     * @class Frustum
+     * @brief Six normalized planes (left, right, bottom, top, near, far) facing inward.
+     *
+     * @tparam T The scalar type. Must be floating point.
+     */
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    class Frustum {
+    public:
+        static constexpr std::size_t plane_count = 6;
+
+        Frustum() = default;
+
+        /// @brief Frustum from planes (nx, ny, nz, d); they are normalized here.
+        explicit Frustum(const std::array<Vector<4, T>, plane_count> &planes) {
+            for (std::size_t p = 0; p < plane_count; ++p) {
+                const auto &plane = planes[p];
+                const auto length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+                assert(length > 0 && "Degenerate frustum plane.");
+                _planes[p] = plane * (T(1) / length);
+            }
+        }
+
+        /**
+         * @brief Extract the planes of a view-projection matrix (clip = M * p, column vectors).
+         * @param view_projection Projection * view (* model to cull in model space).
+         * @param depth Clip-space depth convention of the projection.
+         */
+        [[nodiscard]] static Frustum from_matrix(const Matrix<4, 4, T> &view_projection,
+                                                 ClipDepth depth = ClipDepth::NegativeOneToOne) {
+            const auto r0 = view_projection.row(0), r1 = view_projection.row(1);
+            const auto r2 = view_projection.row(2), r3 = view_projection.row(3);
+            return Frustum({
+                r3 + r0, r3 - r0,
+                r3 + r1, r3 - r1,
+                depth == ClipDepth::ZeroToOne ? r2 : r3 + r2, r3 - r2
+            });
+        }
+
+        /// @brief Plane `p` as (nx, ny, nz, d).
+        [[nodiscard]] const Vector<4, T> &plane(std::size_t p) const {
+            return _planes[p];
+        }
+
+        /// @brief Signed distance from plane `p` to `point` (positive inside).
+        [[nodiscard]] T distance(std::size_t p, const Vector<3, T> &point) const {
+            const auto &plane = _planes[p];
+            return plane[0] * point[0] + plane[1] * point[1] + plane[2] * point[2] + plane[3];
+        }
+
+        /// @brief True if the sphere is at least partially inside (conservative near corners).
+        [[nodiscard]] bool intersects_sphere(const Vector<3, T> &center, T radius) const {
+            for (std::size_t p = 0; p < plane_count; ++p) {
+                if (distance(p, center) < -radius) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// @brief True if the box is at least partially inside (conservative near corners).
+        [[nodiscard]] bool intersects_aabb(const Vector<3, T> &min, const Vector<3, T> &max) const {
+            const auto center = (min + max) * T(0.5);
+            const auto extent = (max - min) * T(0.5);
+            for (std::size_t p = 0; p < plane_count; ++p) {
+                if (distance(p, center) < -projected_radius(p, extent)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// @brief Radius of a box with half-size `extent` projected on the normal of plane `p`.
+        [[nodiscard]] T projected_radius(std::size_t p, const Vector<3, T> &extent) const {
+            const auto &plane = _planes[p];
+            return std::abs(plane[0]) * extent[0] + std::abs(plane[1]) * extent[1] + std::abs(plane[2]) * extent[2];
+        }
+
+    private:
+        std::array<Vector<4, T>, plane_count> _planes{};
+    };
+
+    /**
+     * @brief Node of a depth-first bounding volume tree for `cull_hierarchy`.
+     *
+     * The subtree of node `i` occupies nodes [i, skip), so a leaf has `skip == i + 1`.
+     * Objects are ordered so that every subtree owns the contiguous range
+     * [first_object, first_object + object_count).
+     */
+    template<typename T>
+    struct CullNode {
+        Vector<3, T> min;
+        Vector<3, T> max;
+        std::uint32_t skip;
+        std::uint32_t first_object;
+        std::uint32_t object_count;
+    };
+
+    namespace detail {
+        /// Append the indices `offset + j` with mask[j] != 0, branch-free.
+        inline void compact_visible(std::span<const std::uint8_t> mask, std::size_t offset,
+                                    std::vector<std::uint32_t> &visible) {
+            const auto base = visible.size();
+            visible.resize(base + mask.size());
+            auto written = base;
+            for (std::size_t j = 0; j < mask.size(); ++j) {
+                visible[written] = static_cast<std::uint32_t>(offset + j);
+                written += mask[j];
+            }
+            visible.resize(written);
+        }
+
+        /// Run `cull_range(begin, end, out)` over [0, count) and concatenate the per-chunk lists in order.
+        template<typename CullRange>
+        void cull_parallel(std::size_t count, std::vector<std::uint32_t> &visible, unsigned int threads,
+                           CullRange &&cull_range) {
+            visible.clear();
+            if (threads <= 1) {
+                cull_range(0, count, visible);
+                return;
+            }
+            std::vector<std::vector<std::uint32_t>> partial(threads);
+            parallel_for(count, [&](std::size_t begin, std::size_t end, unsigned int t) {
+                cull_range(begin, end, partial[t]);
+            }, threads);
+            for (const auto &part: partial) {
+                visible.insert(visible.end(), part.begin(), part.end());
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @brief Indices of the spheres intersecting the frustum, in increasing order.
+     *
+     * @param centers Sphere centers.
+     * @param radii Sphere radii.
+     * @param visible Cleared, then filled with the visible indices.
+     * @param threads Number of worker threads.
+     */
+    template<typename T>
+    void cull_spheres(const Frustum<T> &frustum, SoASpan<3, const T> centers, std::span<const T> radii,
+                      std::vector<std::uint32_t> &visible, unsigned int threads = 1) {
+        assert(radii.size() >= centers.size() && "Missing sphere radii.");
+        const auto x = centers.component(0), y = centers.component(1), z = centers.component(2);
+        detail::cull_parallel(centers.size(), visible, threads,
+                              [&](std::size_t begin, std::size_t end, std::vector<std::uint32_t> &out) {
+            std::array<std::uint8_t, cull_block_size> mask;
+            for (auto block = begin; block < end; block += cull_block_size) {
+                const auto n = std::min(cull_block_size, end - block);
+                mask.fill(1);
+                const T *px = x.data() + block, *py = y.data() + block, *pz = z.data() + block;
+                const T *pr = radii.data() + block;
+                for (std::size_t p = 0; p < Frustum<T>::plane_count; ++p) {
+                    // Plane and pointers in locals: the byte stores to `mask` may alias anything.
+                    const auto &plane = frustum.plane(p);
+                    const auto a = plane[0], b = plane[1], c = plane[2], d0 = plane[3];
+                    for (std::size_t j = 0; j < n; ++j) {
+                        const auto d = a * px[j] + b * py[j] + c * pz[j] + d0;
+                        mask[j] &= static_cast<std::uint8_t>(d >= -pr[j]);
+                    }
+                }
+                detail::compact_visible(std::span<const std::uint8_t>(mask.data(), n), block, out);
+            }
+        });
+    }
+
+    /**
+     * @brief Indices of the axis-aligned boxes intersecting the frustum, in increasing order.
+     *
+     * @param mins Box minimum corners.
+     * @param maxs Box maximum corners.
+     * @param visible Cleared, then filled with the visible indices.
+     * @param threads Number of worker threads.
+     */
+    template<typename T>
+    void cull_aabbs(const Frustum<T> &frustum, SoASpan<3, const T> mins, SoASpan<3, const T> maxs,
+                    std::vector<std::uint32_t> &visible, unsigned int threads = 1) {
+        assert(maxs.size() >= mins.size() && "Missing box maximum corners.");
+        const auto x0 = mins.component(0), y0 = mins.component(1), z0 = mins.component(2);
+        const auto x1 = maxs.component(0), y1 = maxs.component(1), z1 = maxs.component(2);
+        detail::cull_parallel(mins.size(), visible, threads,
+                              [&](std::size_t begin, std::size_t end, std::vector<std::uint32_t> &out) {
+            std::array<std::uint8_t, cull_block_size> mask;
+            for (auto block = begin; block < end; block += cull_block_size) {
+                const auto n = std::min(cull_block_size, end - block);
+                mask.fill(1);
+                const T *px0 = x0.data() + block, *py0 = y0.data() + block, *pz0 = z0.data() + block;
+                const T *px1 = x1.data() + block, *py1 = y1.data() + block, *pz1 = z1.data() + block;
+                for (std::size_t p = 0; p < Frustum<T>::plane_count; ++p) {
+                    const auto &plane = frustum.plane(p);
+                    const auto a = plane[0], b = plane[1], c = plane[2], d2 = T(2) * plane[3];
+                    const auto ax = std::abs(a), ay = std::abs(b), az = std::abs(c);
+                    for (std::size_t j = 0; j < n; ++j) {
+                        // Center / half-extent form: 2d and 2r, the factor 1/2 cancels out.
+                        const auto d = a * (px0[j] + px1[j]) + b * (py0[j] + py1[j]) + c * (pz0[j] + pz1[j]) + d2;
+                        const auto r = ax * (px1[j] - px0[j]) + ay * (py1[j] - py0[j]) + az * (pz1[j] - pz0[j]);
+                        mask[j] &= static_cast<std::uint8_t>(d >= -r);
+                    }
+                }
+                detail::compact_visible(std::span<const std::uint8_t>(mask.data(), n), block, out);
+            }
+        });
+    }
+
+    /**
+     * @brief Hierarchical culling over a depth-first bounding volume tree.
+     *
+     * Intersecting leaves test their objects against the planes still active; subtrees fully
+     * inside the frustum are accepted wholesale.
+     *
+     * @param nodes Tree nodes in depth-first order, root first (see `CullNode`).
+     * @param object_mins Object box minimum corners, indexed by object.
+     * @param object_maxs Object box maximum corners.
+     * @param visible Cleared, then filled with the visible object indices in increasing order.
+     */
+    template<typename T>
+    void cull_hierarchy(const Frustum<T> &frustum, std::span<const CullNode<T>> nodes,
+                        SoASpan<3, const T> object_mins, SoASpan<3, const T> object_maxs,
+                        std::vector<std::uint32_t> &visible) {
+        constexpr std::uint8_t all_planes = (1u << Frustum<T>::plane_count) - 1;
+        visible.clear();
+
+        // Result of testing a box against the active planes: outside, or the planes it straddles.
+        const auto classify = [&](const Vector<3, T> &min, const Vector<3, T> &max, std::uint8_t planes,
+                                  bool &outside) {
+            const auto center = (min + max) * T(0.5);
+            const auto extent = (max - min) * T(0.5);
+            std::uint8_t straddled = 0;
+            outside = false;
+            for (std::size_t p = 0; p < Frustum<T>::plane_count; ++p) {
+                if (!(planes & (1u << p))) {
+                    continue;
+                }
+                const auto d = frustum.distance(p, center);
+                const auto r = frustum.projected_radius(p, extent);
+                if (d < -r) {
+                    outside = true;
+                    return straddled;
+                }
+                if (d < r) {
+                    straddled |= static_cast<std::uint8_t>(1u << p);
+                }
+            }
+            return straddled;
+        };
+
+        // (subtree end, planes still active inside it)
+        std::vector<std::pair<std::uint32_t, std::uint8_t>> stack;
+        std::size_t i = 0;
+        while (i < nodes.size()) {
+            while (!stack.empty() && i >= stack.back().first) {
+                stack.pop_back();
+            }
+            const auto planes = stack.empty() ? all_planes : stack.back().second;
+
+            const auto &node = nodes[i];
+            assert(node.skip > i && "Node skip index must point past its subtree.");
+            bool outside;
+            const auto straddled = classify(node.min, node.max, planes, outside);
+            if (outside) {
+                i = node.skip;
+                continue;
+            }
+            if (straddled == 0 || node.skip != i + 1) {
+                if (straddled == 0) {
+                    // Fully inside: accept the whole subtree.
+                    for (std::uint32_t o = 0; o < node.object_count; ++o) {
+                        visible.push_back(node.first_object + o);
+                    }
+                    i = node.skip;
+                } else {
+                    stack.emplace_back(node.skip, straddled);
+                    ++i;
+                }
+                continue;
+            }
+
+            // Straddling leaf: test its objects against the remaining planes.
+            for (std::uint32_t o = node.first_object; o < node.first_object + node.object_count; ++o) {
+                classify(object_mins.load(o), object_maxs.load(o), straddled, outside);
+                if (!outside) {
+                    visible.push_back(o);
+                }
+            }
+            ++i;
+        }
+    }
+} // namespace Geometry
+
+#endif // CULLING_H
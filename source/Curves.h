@@ -0,0 +1,383 @@
+/**
+ * @file Curves.h
+ * @brief Piecewise cubic curves (Bezier, Catmull-Rom, uniform B-spline) with batched evaluation.
+ *
+ * Every curve type is converted once to power-basis segments p(t) = c0 + c1 t + c2 t^2 + c3 t^3,
+ * t in [0, 1], so evaluation is the same Horner scheme (3 multiply-adds per component)
+ * whatever the input basis, and derivatives come directly from the coefficients.
+ *
+ * A curve is parameterized by u in [0, segment_count()]: segment floor(u) at t = u - floor(u).
+ * Batched evaluation writes SoA output so the Horner loop vectorizes across parameters;
+ * `sample_uniform` uses forward differencing (3 additions per component and sample).
+ * `ArcLengthTable` maps distance along the curve back to u for constant-speed motion.
+ * Requires C++20
+ */
+
+#ifndef CURVES_H
+#define CURVES_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Parallel.h"
+#include "SoA.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /**
+     * @class CubicSegment
+     * @brief One cubic polynomial segment in power basis, t in [0, 1].
+     *
+     * @tparam Dim Dimension of the control points.
+     * @tparam T The scalar type. Must be floating point.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    class CubicSegment {
+    public:
+        using Point = Vector<Dim, T>;
+
+        CubicSegment() = default;
+
+        /// @brief Segment c0 + c1 t + c2 t^2 + c3 t^3.
+        constexpr CubicSegment(const Point &c0, const Point &c1, const Point &c2, const Point &c3)
+            : _c{c0, c1, c2, c3} {
+        }
+
+        /// @brief Cubic Bezier from p0 to p3 with handles p1, p2.
+        [[nodiscard]] static constexpr CubicSegment bezier(const Point &p0, const Point &p1,
+                                                           const Point &p2, const Point &p3) {
+            return CubicSegment(p0,
+                                (p1 - p0) * T(3),
+                                (p0 - p1 * T(2) + p2) * T(3),
+                                p3 - p0 + (p1 - p2) * T(3));
+        }
+
+        /// @brief Uniform Catmull-Rom segment from p1 to p2 (p0 and p3 are the neighbours).
+        [[nodiscard]] static constexpr CubicSegment catmull_rom(const Point &p0, const Point &p1,
+                                                                const Point &p2, const Point &p3) {
+            return CubicSegment(p1,
+                                (p2 - p0) * T(0.5),
+                                (p0 * T(2) - p1 * T(5) + p2 * T(4) - p3) * T(0.5),
+                                (p3 - p0 + (p1 - p2) * T(3)) * T(0.5));
+        }
+
+        /// @brief Uniform cubic B-spline segment of the control points p0..p3 (does not interpolate them).
+        [[nodiscard]] static constexpr CubicSegment bspline(const Point &p0, const Point &p1,
+                                                            const Point &p2, const Point &p3) {
+            constexpr auto sixth = T(1) / T(6);
+            return CubicSegment((p0 + p1 * T(4) + p2) * sixth,
+                                (p2 - p0) * T(0.5),
+                                (p0 - p1 * T(2) + p2) * T(0.5),
+                                (p3 - p0 + (p1 - p2) * T(3)) * sixth);
+        }
+
+        /// @brief Power-basis coefficient `i` (0..3).
+        [[nodiscard]] constexpr const Point &coefficient(std::size_t i) const {
+            return _c[i];
+        }
+
+        /// @brief Position at t (Horner).
+        [[nodiscard]] constexpr Point evaluate(T t) const {
+            return ((_c[3] * t + _c[2]) * t + _c[1]) * t + _c[0];
+        }
+
+        /// @brief First derivative dp/dt (tangent, not normalized).
+        [[nodiscard]] constexpr Point derivative(T t) const {
+            return (_c[3] * (T(3) * t) + _c[2] * T(2)) * t + _c[1];
+        }
+
+        /// @brief Second derivative d2p/dt2.
+        [[nodiscard]] constexpr Point second_derivative(T t) const {
+            return _c[3] * (T(6) * t) + _c[2] * T(2);
+        }
+
+    private:
+        std::array<Point, 4> _c{};
+    };
+
+    /**
+     * @class CubicCurve
+     * @brief Sequence of cubic segments parameterized by u in [0, segment_count()].
+     *
+     * @tparam Dim Dimension of the control points.
+     * @tparam T The scalar type. Must be floating point.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    class CubicCurve {
+    public:
+        using Point = Vector<Dim, T>;
+        using Segment = CubicSegment<Dim, T>;
+
+        CubicCurve() = default;
+
+        explicit CubicCurve(std::vector<Segment> segments) : _segments(std::move(segments)) {
+        }
+
+        /**
+         * @brief Piecewise Bezier curve; segment i uses control points [3i, 3i + 3].
+         * @param control 3n + 1 control points for n segments.
+         */
+        [[nodiscard]] static CubicCurve bezier(std::span<const Point> control) {
+            assert(control.size() >= 4 && (control.size() - 1) % 3 == 0 && "Bezier curves need 3n + 1 control points.");
+            std::vector<Segment> segments;
+            for (std::size_t i = 0; i + 3 < control.size(); i += 3) {
+                segments.push_back(Segment::bezier(control[i], control[i + 1], control[i + 2], control[i + 3]));
+            }
+            return CubicCurve(std::move(segments));
+        }
+
+        /**
+         * @brief Catmull-Rom spline through points[1] .. points[n - 2].
+         * @note The first and last points only shape the end tangents.
+         */
+        [[nodiscard]] static CubicCurve catmull_rom(std::span<const Point> points) {
+            assert(points.size() >= 4 && "Catmull-Rom splines need at least 4 points.");
+            std::vector<Segment> segments;
+            for (std::size_t i = 0; i + 3 < points.size(); ++i) {
+                segments.push_back(Segment::catmull_rom(points[i], points[i + 1], points[i + 2], points[i + 3]));
+            }
+            return CubicCurve(std::move(segments));
+        }
+
+        /// @brief Uniform cubic B-spline (C2 continuous, approximating) of at least 4 control points.
+        [[nodiscard]] static CubicCurve bspline(std::span<const Point> control) {
+            assert(control.size() >= 4 && "B-splines need at least 4 control points.");
+            std::vector<Segment> segments;
+            for (std::size_t i = 0; i + 3 < control.size(); ++i) {
+                segments.push_back(Segment::bspline(control[i], control[i + 1], control[i + 2], control[i + 3]));
+            }
+            return CubicCurve(std::move(segments));
+        }
+
+        [[nodiscard]] std::size_t segment_count() const {
+            return _segments.size();
+        }
+
+        [[nodiscard]] const Segment &segment(std::size_t i) const {
+            return _segments[i];
+        }
+
+        /// @brief Segment index and local t of parameter u (clamped to the curve).
+        [[nodiscard]] std::pair<std::size_t, T> locate(T u) const {
+            assert(!_segments.empty() && "Empty curve.");
+            const auto last = _segments.size() - 1;
+            const auto clamped = std::clamp(u, T(0), static_cast<T>(_segments.size()));
+            const auto i = std::min(static_cast<std::size_t>(clamped), last);
+            return {i, clamped - static_cast<T>(i)};
+        }
+
+        [[nodiscard]] Point evaluate(T u) const {
+            const auto [i, t] = locate(u);
+            return _segments[i].evaluate(t);
+        }
+
+        /// @brief dp/du (not normalized).
+        [[nodiscard]] Point derivative(T u) const {
+            const auto [i, t] = locate(u);
+            return _segments[i].derivative(t);
+        }
+
+        /// @brief Unit tangent at u.
+        [[nodiscard]] Point tangent(T u) const {
+            return derivative(u).normalized();
+        }
+
+        /**
+         * @brief Evaluate positions at many parameters into SoA storage.
+         * @note The per-component Horner loop vectorizes across parameters.
+         */
+        void evaluate(std::span<const T> parameters, SoASpan<Dim, T> out) const {
+            evaluate_batch(parameters, out, false);
+        }
+
+        /// @brief Evaluate dp/du at many parameters into SoA storage.
+        void derivative(std::span<const T> parameters, SoASpan<Dim, T> out) const {
+            evaluate_batch(parameters, out, true);
+        }
+
+        /// @brief Number of points written by `sample_uniform(samples_per_segment, ...)`.
+        [[nodiscard]] std::size_t uniform_sample_count(std::size_t samples_per_segment) const {
+            return _segments.size() * samples_per_segment + 1;
+        }
+
+        /**
+         * @brief Sample u = k / samples_per_segment for every k, end point included.
+         *
+         * Uses forward differencing restarted at every segment, so the rounding drift is
+         * bounded by one segment; prefer `evaluate` when exact positions matter.
+         * @param out Receives `uniform_sample_count(samples_per_segment)` points.
+         */
+        void sample_uniform(std::size_t samples_per_segment, SoASpan<Dim, T> out) const {
+            assert(samples_per_segment > 0 && "Need at least one sample per segment.");
+            assert(out.size() >= uniform_sample_count(samples_per_segment) && "Output span is too small.");
+            const auto h = T(1) / static_cast<T>(samples_per_segment);
+            for (std::size_t s = 0; s < _segments.size(); ++s) {
+                const auto &seg = _segments[s];
+                for (auto c = 0u; c < Dim; ++c) {
+                    const auto c1 = seg.coefficient(1)[c], c2 = seg.coefficient(2)[c], c3 = seg.coefficient(3)[c];
+                    auto p = seg.coefficient(0)[c];
+                    auto d1 = ((c3 * h + c2) * h + c1) * h;
+                    auto d2 = (T(6) * c3 * h + T(2) * c2) * h * h;
+                    const auto d3 = T(6) * c3 * h * h * h;
+                    auto dst = out.component(c).subspan(s * samples_per_segment, samples_per_segment);
+                    for (auto &value: dst) {
+                        value = p;
+                        p += d1;
+                        d1 += d2;
+                        d2 += d3;
+                    }
+                }
+            }
+            out.store(uniform_sample_count(samples_per_segment) - 1, _segments.back().evaluate(T(1)));
+        }
+
+        /**
+         * @brief Parameter of the point of the curve closest to `query`.
+         *
+         * Picks the nearest of `samples_per_segment` samples per segment, then refines with
+         * Newton iterations on (p(t) - q) . p'(t) = 0 inside that segment.
+         */
+        [[nodiscard]] T closest_parameter(const Point &query, std::size_t samples_per_segment = 16,
+                                          unsigned int iterations = 4) const {
+            assert(!_segments.empty() && "Empty curve.");
+            std::size_t best_segment = 0;
+            T best_t = 0;
+            auto best_distance = std::numeric_limits<T>::max();
+            const auto h = T(1) / static_cast<T>(samples_per_segment);
+            for (std::size_t s = 0; s < _segments.size(); ++s) {
+                for (std::size_t k = 0; k <= samples_per_segment; ++k) {
+                    const auto t = static_cast<T>(k) * h;
+                    const auto distance = (_segments[s].evaluate(t) - query).squared_mag();
+                    if (distance < best_distance) {
+                        best_distance = distance;
+                        best_segment = s;
+                        best_t = t;
+                    }
+                }
+            }
+
+            const auto &seg = _segments[best_segment];
+            for (unsigned int it = 0; it < iterations; ++it) {
+                const auto offset = seg.evaluate(best_t) - query;
+                const auto d1 = seg.derivative(best_t);
+                const auto f = offset.dot(d1);
+                const auto df = d1.dot(d1) + offset.dot(seg.second_derivative(best_t));
+                if (df <= 0) {
+                    break;
+                }
+                best_t = std::clamp(best_t - f / df, T(0), T(1));
+            }
+            return static_cast<T>(best_segment) + best_t;
+        }
+
+        /// @brief `closest_parameter` for every query point, split across threads.
+        void closest_parameters(SoASpan<Dim, const T> queries, std::span<T> out,
+                                std::size_t samples_per_segment = 16, unsigned int iterations = 4,
+                                unsigned int threads = 1) const {
+            assert(out.size() >= queries.size() && "Output span is too small.");
+            parallel_for(queries.size(), [&](std::size_t begin, std::size_t end, unsigned int) {
+                for (auto i = begin; i < end; ++i) {
+                    out[i] = closest_parameter(queries.load(i), samples_per_segment, iterations);
+                }
+            }, threads);
+        }
+
+    private:
+        void evaluate_batch(std::span<const T> parameters, SoASpan<Dim, T> out, bool derivative) const {
+            assert(out.size() >= parameters.size() && "Output span is too small.");
+            constexpr std::size_t block = 64;
+            std::array<const Segment *, block> segments;
+            std::array<T, block> local;
+            for (std::size_t first = 0; first < parameters.size(); first += block) {
+                const auto n = std::min(block, parameters.size() - first);
+                for (std::size_t j = 0; j < n; ++j) {
+                    const auto [i, t] = locate(parameters[first + j]);
+                    segments[j] = &_segments[i];
+                    local[j] = t;
+                }
+                for (auto c = 0u; c < Dim; ++c) {
+                    const auto dst = out.component(c).subspan(first, n);
+                    for (std::size_t j = 0; j < n; ++j) {
+                        const auto &seg = *segments[j];
+                        const auto t = local[j];
+                        dst[j] = derivative
+                                     ? (T(3) * seg.coefficient(3)[c] * t + T(2) * seg.coefficient(2)[c]) * t
+                                       + seg.coefficient(1)[c]
+                                     : ((seg.coefficient(3)[c] * t + seg.coefficient(2)[c]) * t
+                                        + seg.coefficient(1)[c]) * t + seg.coefficient(0)[c];
+                    }
+                }
+            }
+        }
+
+        std::vector<Segment> _segments;
+    };
+
+    /**
+     * @class ArcLengthTable
+     * @brief Cumulative chord lengths of a curve, mapping distance to curve parameter.
+     *
+     * Accuracy is that of the chord approximation with `samples_per_segment` chords per
+     * segment; the inverse lookup is a binary search plus linear interpolation.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    class ArcLengthTable {
+    public:
+        ArcLengthTable(const CubicCurve<Dim, T> &curve, std::size_t samples_per_segment = 32)
+            : _step(T(1) / static_cast<T>(samples_per_segment)) {
+            SoAArray<Dim, T> points(curve.uniform_sample_count(samples_per_segment));
+            curve.sample_uniform(samples_per_segment, points.span());
+            const auto samples = std::as_const(points).span();
+            _lengths.resize(samples.size());
+            _lengths[0] = 0;
+            for (std::size_t i = 1; i < samples.size(); ++i) {
+                _lengths[i] = _lengths[i - 1] + (samples.load(i) - samples.load(i - 1)).magnitude();
+            }
+        }
+
+        /// @brief Total length of the curve.
+        [[nodiscard]] T length() const {
+            return _lengths.back();
+        }
+
+        /// @brief Curve parameter u at distance `s` from the start (clamped to [0, length()]).
+        [[nodiscard]] T parameter_at(T s) const {
+            if (s <= 0) {
+                return 0;
+            }
+            if (s >= length()) {
+                return static_cast<T>(_lengths.size() - 1) * _step;
+            }
+            const auto upper = std::upper_bound(_lengths.begin(), _lengths.end(), s);
+            const auto i = static_cast<std::size_t>(upper - _lengths.begin()) - 1;
+            const auto span = _lengths[i + 1] - _lengths[i];
+            const auto fraction = span > 0 ? (s - _lengths[i]) / span : T(0);
+            return (static_cast<T>(i) + fraction) * _step;
+        }
+
+        /// @brief `parameter_at` for many distances.
+        void parameters_at(std::span<const T> distances, std::span<T> out) const {
+            assert(out.size() >= distances.size() && "Output span is too small.");
+            for (std::size_t i = 0; i < distances.size(); ++i) {
+                out[i] = parameter_at(distances[i]);
+            }
+        }
+
+    private:
+        T _step;
+        std::vector<T> _lengths;
+    };
+} // namespace Geometry
+
+#endif // CURVES_H
@@ -0,0 +1,641 @@
+/**
+ * @file FastMath.h
+ * @brief Branch-free polynomial sin, cos, sincos, atan2, acos, exp and log.
+ *
+ * `<cmath>` calls are opaque to the vectorizer, so a loop computing `std::acos(a.dot(b))`
+ * runs one element at a time. The functions in `Geometry::fastmath` are straight-line
+ * arithmetic (range reduction, polynomial, reconstruction) with bit-mask selects instead of
+ * branches, so the span forms compile to packed SIMD code at -O3 (checked with GCC 12 for
+ * SSE2 to AVX-512; double needs SSE4.2 or later for its 64-bit integer compares). acos also
+ * needs -fno-math-errno, as std::sqrt otherwise keeps an errno branch. Over 2^20 elements
+ * (g++ 12 -O3 -fno-math-errno, one core) float runs 1.6x (sin) to 5.6x (atan2) faster than
+ * the libm loop on baseline x86-64 and 2x to 8x with -mavx2. Double pays off with -mavx2 only:
+ * 1.4x (log) to 5x (sincos), acos at libm speed; on baseline x86-64 it is slower than libm.
+ *
+ * Polynomials are the Cephes minimax ones for float and Taylor / atanh series for double.
+ * Two accuracy tiers:
+ * - `MathAccuracy::Precise`: three-part Cody-Waite reduction (done in double for float
+ *   sin / cos) and IEEE results for zero, denormal, infinite and NaN arguments, exp
+ *   overflow and gradual underflow. The split of pi / 2 stays exact up to |x| = 1.6e6;
+ *   sin / cos of larger arguments call libm. The span forms check blocks of 64 arguments,
+ *   so only blocks holding such an argument leave the vectorized loop.
+ * - `MathAccuracy::Fast`: two-part reduction, no special cases. sin / cos need |x| <= 1e4,
+ *   exp a normal result below 2^127.5 (2^1023.5 for double), log a positive normal argument,
+ *   atan2 finite arguments not both 0.
+ *
+ * Max error against glibc long double over 2^22 random arguments per function (main.cpp
+ * re-checks these bounds on 2^18):
+ *
+ * | function | arguments           | float precise | float fast      | double (both tiers) |
+ * |----------|---------------------|---------------|-----------------|---------------------|
+ * | sin, cos | finite / abs <= 1e4 | 1.6 ulp       | 1.6e-7 absolute | 1.6 ulp             |
+ * | atan2    | finite              | 3.0 ulp       | 3.2 ulp         | 3.0 ulp             |
+ * | acos     | [-1, 1]             | 1.3 ulp       | 1.3 ulp         | 3.4 ulp             |
+ * | exp      | normal results      | 1.3 ulp       | 1.3 ulp         | 1.3 ulp             |
+ * | log      | positive normal     | 0.8 ulp       | 0.8 ulp         | 0.8 ulp             |
+ *
+ * Fast float sin / cos lose relative accuracy next to their zeros, hence the absolute bound.
+ * Requires C++20
+ */
+
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+namespace Geometry {
+    /// @brief Accuracy / speed trade-off of the `fastmath` functions.
+    enum class MathAccuracy {
+        Precise, ///< 1-3.5 ulp, IEEE special cases handled.
+        Fast ///< Same polynomials with a cheaper reduction and no special cases.
+    };
+
+    namespace fastmath {
+        namespace detail {
+            /// Series coefficients +-scale / (2k + 1) in Horner order, k = first + N - 1 down to first.
+            template<std::size_t N>
+            constexpr std::array<double, N> odd_reciprocal_series(std::size_t first, bool alternating, double scale) {
+                std::array<double, N> coefficients{};
+                for (std::size_t i = 0; i < N; ++i) {
+                    const auto k = first + N - 1 - i;
+                    coefficients[i] = (alternating && (k & 1) ? -scale : scale) / static_cast<double>(2 * k + 1);
+                }
+                return coefficients;
+            }
+
+            template<typename T>
+            struct Constants;
+
+            template<>
+            struct Constants<float> {
+                using Int = std::int32_t;
+                static constexpr int mantissa_bits = 23;
+                static constexpr int exponent_bias = 127;
+
+                // pi / 2 split so that q * pio2_hi is exact for |q| < 2^16.
+                static constexpr float pio2_hi = 1.5703125f;
+                static constexpr float pio2_mid = 4.837512969970703125e-4f;
+                static constexpr float pio2_lo = 7.54978995489188216e-8f;
+                static constexpr float ln2_hi = 0.693359375f;
+                static constexpr float ln2_lo = -2.12194440e-4f;
+                static constexpr float exp_max = 88.72283905206835f;
+                static constexpr float exp_min = -103.97208f;
+
+                // sin(r) = r + r^3 P(r^2), cos(r) = 1 - r^2 / 2 + r^4 Q(r^2) on [-pi/4, pi/4].
+                static constexpr std::array<float, 3> sin_coefficients = {
+                    -1.9515295891e-4f, 8.3321608736e-3f, -1.6666654611e-1f
+                };
+                static constexpr std::array<float, 3> cos_coefficients = {
+                    2.443315711809948e-5f, -1.388731625493765e-3f, 4.166664568298827e-2f
+                };
+                // exp(r) = 1 + r + r^2 P(r) on [-ln2 / 2, ln2 / 2].
+                static constexpr std::array<float, 6> exp_coefficients = {
+                    1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f, 4.1665795894e-2f, 1.6666665459e-1f,
+                    5.0000001201e-1f
+                };
+                // atan(t) = t + t^3 P(t^2) on [0, tan(pi / 8)].
+                static constexpr std::array<float, 4> atan_coefficients = {
+                    8.05374449538e-2f, -1.38776856032e-1f, 1.99777106478e-1f, -3.33329491539e-1f
+                };
+            };
+
+            template<>
+            struct Constants<double> {
+                using Int = std::int64_t;
+                static constexpr int mantissa_bits = 52;
+                static constexpr int exponent_bias = 1023;
+
+                // pi / 2 split so that q * pio2_hi is exact for |q| < 2^20.
+                static constexpr double pio2_hi = 1.5707963267341256;
+                static constexpr double pio2_mid = 6.077100506303966e-11;
+                static constexpr double pio2_lo = 2.0222662487959506e-21;
+                static constexpr double ln2_hi = 0.6931471803691238;
+                static constexpr double ln2_lo = 1.9082149292705877e-10;
+                static constexpr double exp_max = 709.782712893384;
+                static constexpr double exp_min = -745.1332191019412;
+
+                // Taylor coefficients: (-1)^k / (2k + 1)! and (-1)^k / (2k)!.
+                static constexpr std::array<double, 7> sin_coefficients = {
+                    -7.647163731819816e-13, 1.6059043836821613e-10, -2.505210838544172e-08, 2.7557319223985893e-06,
+                    -0.0001984126984126984, 0.008333333333333333, -0.16666666666666666
+                };
+                static constexpr std::array<double, 7> cos_coefficients = {
+                    4.779477332387385e-14, -1.1470745597729725e-11, 2.08767569878681e-09, -2.755731922398589e-07,
+                    2.48015873015873e-05, -0.001388888888888889, 0.041666666666666664
+                };
+                // 1 / k! for k = 13 .. 2.
+                static constexpr std::array<double, 12> exp_coefficients = {
+                    1.6059043836821613e-10, 2.08767569878681e-09, 2.505210838544172e-08, 2.755731922398589e-07,
+                    2.7557319223985893e-06, 2.48015873015873e-05, 0.0001984126984126984, 0.001388888888888889,
+                    0.008333333333333333, 0.041666666666666664, 0.16666666666666666, 0.5
+                };
+                // atan(u) = u P(u^2), Taylor to degree 45: u^2 <= 0.1716 keeps the tail below 2^-56.
+                static constexpr auto atan_coefficients = odd_reciprocal_series<23>(0, true, 1.0);
+                // 2 atanh(s) = 2 s + s R(s^2), R(w) = w (2/3 + 2 w / 5 + ...), to degree 23 in s.
+                static constexpr auto log_coefficients = odd_reciprocal_series<11>(1, false, 2.0);
+            };
+        } // namespace detail
+
+        /**
+         * @brief condition ? a : b as a bit mask.
+         *
+         * A plain select that discards an expensive value lets the compiler move its computation
+         * under a branch, which stops vectorization. Use this one in loops meant to vectorize.
+         */
+        template<typename T>
+            requires std::is_floating_point_v<T>
+        [[nodiscard]] inline T blend(bool condition, T a, T b) {
+            using Int = typename detail::Constants<T>::Int;
+            const auto mask = -static_cast<Int>(condition);
+            return std::bit_cast<T>((std::bit_cast<Int>(a) & mask) | (std::bit_cast<Int>(b) & ~mask));
+        }
+
+        namespace detail {
+            /// Horner evaluation of the coefficients (highest degree first), fully unrolled.
+            template<typename T, std::size_t N>
+            constexpr T horner(const std::array<T, N> &coefficients, T x) {
+                return [&]<std::size_t... I>(std::index_sequence<I...>) {
+                    T result = coefficients[0];
+                    ((result = result * x + coefficients[I + 1]), ...);
+                    return result;
+                }(std::make_index_sequence<N - 1>{});
+            }
+
+            /// 2^n for integral n in the normal exponent range, built from bits.
+            template<typename T>
+            inline T pow2(typename Constants<T>::Int n) {
+                using C = Constants<T>;
+                return std::bit_cast<T>(static_cast<typename C::Int>((n + C::exponent_bias) << C::mantissa_bits));
+            }
+
+            /**
+             * Nearest integer as T and as an integer without a libm call: adding 1.5 * 2^mantissa
+             * leaves the rounded value in the low mantissa bits. Needs |x| < 2^(mantissa - 1).
+             */
+            template<typename T>
+            inline T round_nearest(T x, typename Constants<T>::Int &n) {
+                using Int = typename Constants<T>::Int;
+                constexpr auto magic = T(1.5) * T(Int{1} << Constants<T>::mantissa_bits);
+                const auto shifted = x + magic;
+                n = std::bit_cast<Int>(shifted) - std::bit_cast<Int>(magic);
+                return shifted - magic;
+            }
+
+            /**
+             * x - k c with c split into hi + mid + lo: x - k hi and k mid are exact, and the rounding
+             * error of the second subtraction is recovered before adding the last part.
+             */
+            template<typename T>
+            inline T cody_waite(T x, T k, T hi, T mid, T lo) {
+                const auto t = x - k * hi;
+                const auto w = k * mid;
+                const auto head = t - w;
+                return head + (((t - head) - w) - k * lo);
+            }
+
+            /// Quadrant q = round(x / (pi / 2)) and the reduced argument r in [-pi/4, pi/4].
+            template<MathAccuracy Accuracy, typename T>
+            inline void reduce_quarter_turn(T x, T &r, typename Constants<T>::Int &q) {
+                using C = Constants<T>;
+                if constexpr (Accuracy == MathAccuracy::Precise && std::is_same_v<T, float>) {
+                    // Float lacks the bits for a tight three-part split; reduce in double instead.
+                    using D = Constants<double>;
+                    const auto xd = static_cast<double>(x);
+                    std::int64_t n;
+                    const auto k = round_nearest(xd * (2 / std::numbers::pi), n);
+                    r = static_cast<float>(cody_waite(xd, k, D::pio2_hi, D::pio2_mid, D::pio2_lo));
+                    q = static_cast<typename C::Int>(n);
+                } else {
+                    const auto k = round_nearest(x * T(2 / std::numbers::pi), q);
+                    if constexpr (Accuracy == MathAccuracy::Precise) {
+                        r = cody_waite(x, k, C::pio2_hi, C::pio2_mid, C::pio2_lo);
+                    } else {
+                        constexpr auto pio2_tail = C::pio2_mid + C::pio2_lo;
+                        r = (x - k * C::pio2_hi) - k * pio2_tail;
+                    }
+                }
+            }
+
+            /**
+             * Largest |x| the Precise tier reduces itself: q < 2^20 keeps q * pio2_hi exact in
+             * double. Beyond it the Precise functions call libm.
+             */
+            inline constexpr double trig_reduction_max = 1.6e6;
+
+            /// Whether the Precise tier leaves `x` to libm; never for the Fast tier.
+            template<MathAccuracy Accuracy, typename T>
+            inline bool trig_beyond_reduction(T x) {
+                return Accuracy == MathAccuracy::Precise && std::abs(x) > T(trig_reduction_max);
+            }
+
+            template<typename T>
+            inline T sin_kernel(T r, T z) {
+                return r + r * z * horner(Constants<T>::sin_coefficients, z);
+            }
+
+            template<typename T>
+            inline T cos_kernel(T z) {
+                return T(1) - T(0.5) * z + z * z * horner(Constants<T>::cos_coefficients, z);
+            }
+
+            /// atan(t) for t in [0, 1].
+            template<typename T>
+            inline T atan_unit(T t) {
+                // atan(t) = pi/4 + atan((t - 1) / (t + 1)) brings t to [0, tan(pi/8)].
+                constexpr auto tan_pi_8 = T(0.41421356237309504880);
+                const auto shifted = t > tan_pi_8;
+                const auto u = blend(shifted, (t - T(1)) / (t + T(1)), t);
+                const auto offset = shifted ? T(std::numbers::pi / 4) : T(0);
+                if constexpr (std::is_same_v<T, float>) {
+                    const auto z = u * u;
+                    return offset + u + u * z * horner(Constants<float>::atan_coefficients, z);
+                } else {
+                    return offset + u * horner(Constants<double>::atan_coefficients, u * u);
+                }
+            }
+        } // namespace detail
+
+        namespace detail {
+            /// sin(x), branch-free; the Precise tier needs |x| <= trig_reduction_max.
+            template<MathAccuracy Accuracy, typename T>
+            inline T sin_reduced(T x) {
+                T r;
+                typename Constants<T>::Int q;
+                reduce_quarter_turn<Accuracy>(x, r, q);
+                const auto z = r * r;
+                const auto s = sin_kernel(r, z), c = cos_kernel(z);
+                const auto v = blend((q & 1) != 0, c, s);
+                // The reduction turns -0 into +0; sin(+-0) is x itself.
+                return blend(x == 0, x, blend((q & 2) != 0, -v, v));
+            }
+
+            /// cos(x), branch-free; the Precise tier needs |x| <= trig_reduction_max.
+            template<MathAccuracy Accuracy, typename T>
+            inline T cos_reduced(T x) {
+                T r;
+                typename Constants<T>::Int q;
+                reduce_quarter_turn<Accuracy>(x, r, q);
+                const auto z = r * r;
+                const auto s = sin_kernel(r, z), c = cos_kernel(z);
+                const auto v = blend((q & 1) != 0, s, c);
+                return blend(((q + 1) & 2) != 0, -v, v);
+            }
+
+            /// sin(x) and cos(x), branch-free; the Precise tier needs |x| <= trig_reduction_max.
+            template<MathAccuracy Accuracy, typename T>
+            inline void sincos_reduced(T x, T &sin_x, T &cos_x) {
+                T r;
+                typename Constants<T>::Int q;
+                reduce_quarter_turn<Accuracy>(x, r, q);
+                const auto z = r * r;
+                const auto s = sin_kernel(r, z), c = cos_kernel(z);
+                const auto swap = (q & 1) != 0;
+                const auto vs = blend(swap, c, s), vc = blend(swap, s, c);
+                sin_x = blend(x == 0, x, blend((q & 2) != 0, -vs, vs));
+                cos_x = blend(((q + 1) & 2) != 0, -vc, vc);
+            }
+
+            /**
+             * step(i, reduced) over the indices of `in`, block by block: `reduced` is
+             * std::true_type in blocks where every argument suits the `_reduced` kernels, so
+             * their loop vectorizes, and std::false_type in the rare blocks that need libm.
+             */
+            template<MathAccuracy Accuracy, typename T, typename Step>
+            inline void trig_blocks(std::span<const T> in, Step &&step) {
+                constexpr std::size_t block = 64;
+                for (std::size_t begin = 0; begin < in.size(); begin += block) {
+                    const auto end = std::min(in.size(), begin + block);
+                    // A count rather than a bool: GCC vectorizes the sum, not the or.
+                    std::size_t beyond = 0;
+                    for (auto i = begin; i < end; ++i) {
+                        beyond += trig_beyond_reduction<Accuracy>(in[i]);
+                    }
+                    if (beyond != 0) {
+                        for (auto i = begin; i < end; ++i) {
+                            step(i, std::false_type{});
+                        }
+                    } else {
+                        for (auto i = begin; i < end; ++i) {
+                            step(i, std::true_type{});
+                        }
+                    }
+                }
+            }
+        } // namespace detail
+
+        /// @brief sin(x).
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+            requires std::is_floating_point_v<T>
+        [[nodiscard]] inline T sin(T x) {
+            if (detail::trig_beyond_reduction<Accuracy>(x)) [[unlikely]] {
+                return std::sin(x);
+            }
+            return detail::sin_reduced<Accuracy>(x);
+        }
+
+        /// @brief cos(x).
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+            requires std::is_floating_point_v<T>
+        [[nodiscard]] inline T cos(T x) {
+            if (detail::trig_beyond_reduction<Accuracy>(x)) [[unlikely]] {
+                return std::cos(x);
+            }
+            return detail::cos_reduced<Accuracy>(x);
+        }
+
+        /// @brief sin(x) and cos(x) sharing one range reduction.
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+            requires std::is_floating_point_v<T>
+        inline void sincos(T x, T &sin_x, T &cos_x) {
+            if (detail::trig_beyond_reduction<Accuracy>(x)) [[unlikely]] {
+                sin_x = std::sin(x);
+                cos_x = std::cos(x);
+                return;
+            }
+            detail::sincos_reduced<Accuracy>(x, sin_x, cos_x);
+        }
+
+        /// @brief atan2(y, x) in [-pi, pi].
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+            requires std::is_floating_point_v<T>
+        [[nodiscard]] inline T atan2(T y, T x) {
+            const auto ax = std::abs(x), ay = std::abs(y);
+            const auto steep = ay > ax;
+            const auto num = steep ? ax : ay, den = steep ? ay : ax;
+            auto t = num / den;
+            if constexpr (Accuracy == MathAccuracy::Precise) {
+                // atan2(0, 0) = 0 and atan2(inf, inf) = pi / 4, where the ratio is NaN.
+                t = blend(den == 0, T(0), t);
+                t = blend(std::isinf(num), T(1), t);
+            }
+            auto r = detail::atan_unit(t);
+            r = blend(steep, T(std::numbers::pi / 2) - r, r);
+            // The sign bit tells atan2(0, -0) = pi from atan2(0, 0) = 0.
+            const auto negative_x = Accuracy == MathAccuracy::Precise
+                                        ? std::bit_cast<typename detail::Constants<T>::Int>(x) < 0
+                                        : x < 0;
+            r = blend(negative_x, T(std::numbers::pi) - r, r);
+            return std::copysign(r, y);
+        }
+
+        /// @brief acos(x); NaN outside [-1, 1] in both tiers.
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+            requires std::is_floating_point_v<T>
+        [[nodiscard]] inline T acos(T x) {
+            if constexpr (std::is_same_v<T, float>) {
+                // asin polynomial on [0, 0.5]; for |x| > 0.5 use acos(x) = 2 asin(sqrt((1 - x) / 2)).
+                constexpr std::array<float, 5> asin_coefficients = {
+                    4.2163199048e-2f, 2.4181311049e-2f, 4.5470025998e-2f, 7.4953002686e-2f, 1.6666752422e-1f
+                };
+                const auto a = std::abs(x);
+                const auto large = a > 0.5f;
+                const auto s = blend(large, std::sqrt((1.0f - a) * 0.5f), x);
+                const auto z = s * s;
+                const auto asin_s = s + s * z * detail::horner(asin_coefficients, z);
+                const auto twice = 2.0f * asin_s;
+                const auto from_large = blend(x < 0, std::numbers::pi_v<float> - twice, twice);
+                return blend(large, from_large, std::numbers::pi_v<float> / 2 - asin_s);
+            } else {
+                // (1 - x)(1 + x) keeps sqrt(1 - x^2) accurate near |x| = 1.
+                return atan2<Accuracy>(std::sqrt((T(1) - x) * (T(1) + x)), x);
+            }
+        }
+
+        /// @brief e^x.
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+            requires std::is_floating_point_v<T>
+        [[nodiscard]] inline T exp(T x) {
+            using C = detail::Constants<T>;
+            using Int = typename C::Int;
+            auto xc = x;
+            if constexpr (Accuracy == MathAccuracy::Precise) {
+                // Clamp with selects, which a NaN passes through.
+                xc = blend(x < C::exp_min, C::exp_min, x);
+                xc = blend(xc > C::exp_max, C::exp_max, xc);
+            }
+            Int n;
+            const auto k = detail::round_nearest(xc * T(std::numbers::log2e), n);
+            const auto r = (xc - k * C::ln2_hi) - k * C::ln2_lo;
+            const auto p = T(1) + r + r * r * detail::horner(C::exp_coefficients, r);
+            if constexpr (Accuracy == MathAccuracy::Precise) {
+                // Two factors cover overflow to inf and gradual underflow to denormals / zero.
+                const auto half = n / 2;
+                // A NaN argument stays NaN through the polynomial: only the clamped ends need selects.
+                const auto result = p * detail::pow2<T>(half) * detail::pow2<T>(n - half);
+                return blend(x > C::exp_max, std::numeric_limits<T>::infinity(), blend(x < C::exp_min, T(0), result));
+            } else {
+                return p * detail::pow2<T>(n);
+            }
+        }
+
+        /// @brief Natural logarithm.
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+            requires std::is_floating_point_v<T>
+        [[nodiscard]] inline T log(T x) {
+            using C = detail::Constants<T>;
+            using Int = typename C::Int;
+            auto bits = std::bit_cast<Int>(x);
+            Int exponent_shift = 0;
+            if constexpr (Accuracy == MathAccuracy::Precise) {
+                // Scaling a denormal by 2^mantissa bits makes it normal, exactly.
+                const auto denormal = x < std::numeric_limits<T>::min();
+                constexpr auto scale = T(Int{1} << C::mantissa_bits);
+                bits = std::bit_cast<Int>(blend(denormal, x * scale, x));
+                exponent_shift = denormal ? C::mantissa_bits : 0;
+            }
+            // x = m 2^e with m in [sqrt(1/2), sqrt(2)) using integer operations only: subtracting
+            // the bits of sqrt(1/2) leaves e in the exponent field, borrowing when m would be too small.
+            constexpr auto sqrt_half_bits = std::bit_cast<Int>(T(std::numbers::sqrt2 / 2));
+            const auto k = (bits - sqrt_half_bits) >> C::mantissa_bits;
+            const auto m = std::bit_cast<T>(static_cast<Int>(bits - k * (Int{1} << C::mantissa_bits)));
+            const auto e = k - exponent_shift;
+            // e as T through the magic-number trick of round_nearest, run backwards: a 64-bit integer
+            // conversion has no SIMD instruction before AVX-512DQ.
+            constexpr auto magic = T(1.5) * T(Int{1} << C::mantissa_bits);
+            const auto fe = std::bit_cast<T>(e + std::bit_cast<Int>(magic)) - magic;
+
+            T result;
+            if constexpr (std::is_same_v<T, float>) {
+                constexpr std::array<float, 9> log_coefficients = {
+                    7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f, -1.2420140846e-1f, 1.4249322787e-1f,
+                    -1.6668057665e-1f, 2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f
+                };
+                const auto f = m - 1.0f;
+                const auto z = f * f;
+                auto y = f * z * detail::horner(log_coefficients, f);
+                y += fe * C::ln2_lo;
+                y -= 0.5f * z;
+                result = f + y + fe * C::ln2_hi;
+            } else {
+                // log(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| <= 0.1716, arranged as in fdlibm
+                // so the leading term f = m - 1 is exact: log(m) = f - (f^2 / 2 - s (f^2 / 2 + R(s^2))).
+                const auto f = m - T(1);
+                const auto s = f / (T(2) + f);
+                const auto w = s * s;
+                const auto hfsq = T(0.5) * f * f;
+                const auto r = w * detail::horner(C::log_coefficients, w);
+                result = fe * C::ln2_hi - ((hfsq - (s * (hfsq + r) + fe * C::ln2_lo)) - f);
+            }
+
+            if constexpr (Accuracy == MathAccuracy::Precise) {
+                // log(0) = -inf, log(x < 0) = NaN, log(inf) = inf, log(NaN) = NaN. Positive finite x
+                // are exactly the bit patterns 1 .. inf - 1.
+                using UInt = std::make_unsigned_t<Int>;
+                constexpr auto inf_bits = std::bit_cast<Int>(std::numeric_limits<T>::infinity());
+                const auto x_bits = std::bit_cast<Int>(x);
+                const auto regular = static_cast<UInt>(x_bits) - 1 < static_cast<UInt>(inf_bits) - 1;
+                const auto special = blend((x_bits << 1) == 0, -std::numeric_limits<T>::infinity(),
+                                                   blend(x_bits < 0, std::numeric_limits<T>::quiet_NaN(), x));
+                return blend(regular, result, special);
+            }
+            return result;
+        }
+
+        /**
+         * @name Component-wise Vector forms
+         * @{
+         */
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, unsigned int Dim, typename T>
+        [[nodiscard]] Vector<Dim, T> sin(const Vector<Dim, T> &v) {
+            Vector<Dim, T> result;
+            for (auto i = 0u; i < Dim; ++i) {
+                result[i] = sin<Accuracy>(v[i]);
+            }
+            return result;
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, unsigned int Dim, typename T>
+        [[nodiscard]] Vector<Dim, T> cos(const Vector<Dim, T> &v) {
+            Vector<Dim, T> result;
+            for (auto i = 0u; i < Dim; ++i) {
+                result[i] = cos<Accuracy>(v[i]);
+            }
+            return result;
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, unsigned int Dim, typename T>
+        [[nodiscard]] Vector<Dim, T> atan2(const Vector<Dim, T> &y, const Vector<Dim, T> &x) {
+            Vector<Dim, T> result;
+            for (auto i = 0u; i < Dim; ++i) {
+                result[i] = atan2<Accuracy>(y[i], x[i]);
+            }
+            return result;
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, unsigned int Dim, typename T>
+        [[nodiscard]] Vector<Dim, T> acos(const Vector<Dim, T> &v) {
+            Vector<Dim, T> result;
+            for (auto i = 0u; i < Dim; ++i) {
+                result[i] = acos<Accuracy>(v[i]);
+            }
+            return result;
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, unsigned int Dim, typename T>
+        [[nodiscard]] Vector<Dim, T> exp(const Vector<Dim, T> &v) {
+            Vector<Dim, T> result;
+            for (auto i = 0u; i < Dim; ++i) {
+                result[i] = exp<Accuracy>(v[i]);
+            }
+            return result;
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, unsigned int Dim, typename T>
+        [[nodiscard]] Vector<Dim, T> log(const Vector<Dim, T> &v) {
+            Vector<Dim, T> result;
+            for (auto i = 0u; i < Dim; ++i) {
+                result[i] = log<Accuracy>(v[i]);
+            }
+            return result;
+        }
+        /** @} */
+
+        /**
+         * @name Span forms: out[i] = f(in[i]); `out` may alias `in`.
+         * @{
+         */
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+        void sin(std::span<const T> in, std::span<T> out) {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            detail::trig_blocks<Accuracy>(in, [&](std::size_t i, auto reduced) {
+                if constexpr (reduced) {
+                    out[i] = detail::sin_reduced<Accuracy>(in[i]);
+                } else {
+                    out[i] = sin<Accuracy>(in[i]);
+                }
+            });
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+        void cos(std::span<const T> in, std::span<T> out) {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            detail::trig_blocks<Accuracy>(in, [&](std::size_t i, auto reduced) {
+                if constexpr (reduced) {
+                    out[i] = detail::cos_reduced<Accuracy>(in[i]);
+                } else {
+                    out[i] = cos<Accuracy>(in[i]);
+                }
+            });
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+        void sincos(std::span<const T> in, std::span<T> sin_out, std::span<T> cos_out) {
+            assert(sin_out.size() >= in.size() && cos_out.size() >= in.size() && "Output spans are too small.");
+            detail::trig_blocks<Accuracy>(in, [&](std::size_t i, auto reduced) {
+                if constexpr (reduced) {
+                    detail::sincos_reduced<Accuracy>(in[i], sin_out[i], cos_out[i]);
+                } else {
+                    sincos<Accuracy>(in[i], sin_out[i], cos_out[i]);
+                }
+            });
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+        void atan2(std::span<const T> y, std::span<const T> x, std::span<T> out) {
+            assert(x.size() >= y.size() && out.size() >= y.size() && "Span sizes do not match.");
+            for (std::size_t i = 0; i < y.size(); ++i) {
+                out[i] = atan2<Accuracy>(y[i], x[i]);
+            }
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+        void acos(std::span<const T> in, std::span<T> out) {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = acos<Accuracy>(in[i]);
+            }
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+        void exp(std::span<const T> in, std::span<T> out) {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = exp<Accuracy>(in[i]);
+            }
+        }
+
+        template<MathAccuracy Accuracy = MathAccuracy::Precise, typename T>
+        void log(std::span<const T> in, std::span<T> out) {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = log<Accuracy>(in[i]);
+            }
+        }
+        /** @} */
+    } // namespace fastmath
+} // namespace Geometry
+
+#endif // FASTMATH_H
@@ -0,0 +1,125 @@
+#include "MappedArray.h"
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sched.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Geometry
+{
+    namespace
+    {
+        constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+        std::size_t mapped_size(std::size_t bytes, const MappedArrayOptions &options) {
+            if (!options.huge_pages) {
+                return bytes;
+            }
+            return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+        }
+
+#if defined(__linux__)
+        /// Parse /sys/devices/system/node/online ("0", "0-1", "0,2-3") into a node bit mask.
+        /// Malformed items are skipped, so a bad list only loses nodes instead of throwing.
+        std::uint64_t online_numa_nodes() {
+            std::ifstream file("/sys/devices/system/node/online");
+            std::string list;
+            if (!(file >> list)) {
+                return 0;
+            }
+            std::uint64_t mask = 0;
+            const char *pos = list.data();
+            const char *const end = list.data() + list.size();
+            while (pos < end) {
+                const char *comma = std::find(pos, end, ',');
+                unsigned long first = 0;
+                auto result = std::from_chars(pos, comma, first);
+                auto last = first;
+                if (result.ec == std::errc() && result.ptr != comma && *result.ptr == '-') {
+                    result = std::from_chars(result.ptr + 1, comma, last);
+                }
+                const bool valid = result.ec == std::errc() && result.ptr == comma;
+                for (auto node = first; valid && node <= last && node < 64; ++node) {
+                    mask |= std::uint64_t{1} << node;
+                }
+                pos = comma + 1;
+            }
+            return mask;
+        }
+#endif
+    } // namespace
+
+    namespace detail
+    {
+        void *map_pages(std::size_t bytes, const MappedArrayOptions &options) {
+#if defined(__linux__)
+            const auto size = mapped_size(bytes, options);
+            void *pages = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (pages == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+#if defined(MADV_HUGEPAGE)
+            if (options.huge_pages) {
+                // Advisory only: the kernel falls back to regular pages if THP is disabled.
+                madvise(pages, size, MADV_HUGEPAGE);
+            }
+#endif
+#if defined(SYS_mbind)
+            if (options.interleave_nodes) {
+                constexpr int mpol_interleave = 3; // MPOL_INTERLEAVE from <numaif.h>, without linking libnuma.
+                const auto nodes = online_numa_nodes();
+                if (nodes != 0) {
+                    // Best effort: on failure the pages are simply placed by first touch.
+                    // maxnode counts one past the last bit, as in libnuma.
+                    syscall(SYS_mbind, pages, size, mpol_interleave, &nodes, sizeof(nodes) * 8 + 1, 0);
+                }
+            }
+#endif
+            return pages;
+#else
+            return ::operator new(mapped_size(bytes, options), std::align_val_t{4096});
+#endif
+        }
+
+        void unmap_pages(void *pages, std::size_t bytes, const MappedArrayOptions &options) noexcept {
+#if defined(__linux__)
+            munmap(pages, mapped_size(bytes, options));
+#else
+            ::operator delete(pages, std::align_val_t{4096});
+#endif
+        }
+
+        void pin_to_chunk_cpu(unsigned int chunk, unsigned int chunks) noexcept {
+#if defined(__linux__)
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+                return;
+            }
+            const auto target = std::uint64_t{chunk} * static_cast<std::uint64_t>(CPU_COUNT(&allowed)) / chunks;
+            std::uint64_t seen = 0;
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed) && seen++ == target) {
+                    cpu_set_t pinned;
+                    CPU_ZERO(&pinned);
+                    CPU_SET(cpu, &pinned);
+                    // Best effort, like the placement options: an unpinned chunk still runs.
+                    sched_setaffinity(0, sizeof(pinned), &pinned);
+                    return;
+                }
+            }
+#else
+            (void) chunk;
+            (void) chunks;
+#endif
+        }
+    } // namespace detail
+} // namespace Geometry
@@ -6,5 +6,8 @@
 
 namespace Geometry
 {
-
+    template class Matrix<3, 3, float>;
+    template class Matrix<4, 4, float>;
+    template class Matrix<3, 3, double>;
+    template class Matrix<4, 4, double>;
 } // namespace Geometry
@@ -5,10 +5,23 @@
 #ifndef MATRIX_H
 #define MATRIX_H
 #include <array>
+#include <cstddef>
+#include <ostream>
 #include <type_traits>
+#include <utility>
+
+#include "Vector.h"
 
 namespace Geometry
 {
+    /**
+     * @class Matrix
+     * @brief A generic DimH x DimW matrix stored row-major.
+     *
+     * @tparam DimH Number of rows.
+     * @tparam DimW Number of columns.
+     * @tparam T The scalar type. Must be arithmetic.
+     */
     template<
         unsigned int DimH,
         unsigned int DimW,
@@ -18,7 +31,135 @@ namespace Geometry
     class Matrix {
         private:
             std::array<T, DimH * DimW> _data;
+
+        public:
+            /// @brief Default constructor initializes all elements to 0.
+            constexpr Matrix() : _data{} {
+            }
+
+            /// @brief Constructor with DimH * DimW elements given row by row.
+            template<typename... Args>
+                requires (sizeof...(Args) == DimH * DimW && (std::is_arithmetic_v<std::remove_cvref_t<Args>> && ...))
+            constexpr explicit Matrix(Args &&... args) : _data{static_cast<T>(std::forward<Args>(args))...} {
+            }
+
+            /// @brief Identity matrix (square matrices only).
+            [[nodiscard]] static constexpr Matrix identity() requires (DimH == DimW) {
+                Matrix m;
+                for (auto i = 0u; i < DimH; ++i) {
+                    m(i, i) = T(1);
+                }
+                return m;
+            }
+
+            /// @brief Access the internal row-major data.
+            constexpr const std::array<T, DimH * DimW> &data() const {
+                return _data;
+            }
+
+            /// @brief Const element access by (row, column).
+            constexpr const T &operator()(std::size_t row, std::size_t col) const {
+                return _data[row * DimW + col];
+            }
+
+            /// @brief Mutable element access by (row, column).
+            constexpr T &operator()(std::size_t row, std::size_t col) {
+                return _data[row * DimW + col];
+            }
+
+            /// @brief Get the static number of rows.
+            static constexpr auto rows() {
+                return DimH;
+            }
+
+            /// @brief Get the static number of columns.
+            static constexpr auto cols() {
+                return DimW;
+            }
+
+            /// @brief Row `row` as a vector.
+            [[nodiscard]] constexpr Vector<DimW, T> row(std::size_t row) const {
+                Vector<DimW, T> r;
+                for (auto c = 0u; c < DimW; ++c) {
+                    r[c] = (*this)(row, c);
+                }
+                return r;
+            }
+
+            /// @brief Column `col` as a vector.
+            [[nodiscard]] constexpr Vector<DimH, T> col(std::size_t col) const {
+                Vector<DimH, T> c;
+                for (auto r = 0u; r < DimH; ++r) {
+                    c[r] = (*this)(r, col);
+                }
+                return c;
+            }
+
+            /**
+             * @brief Matrix product.
+             * @return Resulting DimH x DimW2 matrix: C_ij = sum_k A_ik B_kj
+             */
+            template<unsigned int DimW2>
+            [[nodiscard]] constexpr Matrix<DimH, DimW2, T> operator*(const Matrix<DimW, DimW2, T> &other) const {
+                Matrix<DimH, DimW2, T> result;
+                for (auto r = 0u; r < DimH; ++r) {
+                    for (auto k = 0u; k < DimW; ++k) {
+                        const auto a = (*this)(r, k);
+                        for (auto c = 0u; c < DimW2; ++c) {
+                            result(r, c) += a * other(k, c);
+                        }
+                    }
+                }
+                return result;
+            }
+
+            /**
+             * @brief Matrix-vector product.
+             * @return Resulting vector: w_i = sum_k A_ik v_k
+             */
+            [[nodiscard]] constexpr Vector<DimH, T> operator*(const Vector<DimW, T> &v) const {
+                Vector<DimH, T> result;
+                for (auto r = 0u; r < DimH; ++r) {
+                    T sum = 0;
+                    for (auto c = 0u; c < DimW; ++c) {
+                        sum += (*this)(r, c) * v[c];
+                    }
+                    result[r] = sum;
+                }
+                return result;
+            }
+
+            /// @brief Return the transposed matrix.
+            [[nodiscard]] constexpr Matrix<DimW, DimH, T> transposed() const {
+                Matrix<DimW, DimH, T> result;
+                for (auto r = 0u; r < DimH; ++r) {
+                    for (auto c = 0u; c < DimW; ++c) {
+                        result(c, r) = (*this)(r, c);
+                    }
+                }
+                return result;
+            }
+
+            /// @brief Equality operator (element-wise).
+            constexpr bool operator==(const Matrix &other) const {
+                return _data == other._data;
+            }
+
+            /// @brief Pretty print a matrix, one row per bracket.
+            friend std::ostream &operator<<(std::ostream &os, const Matrix &m) {
+                os << "Matrix" << DimH << 'x' << DimW << '[';
+                for (auto r = 0u; r < DimH; ++r) {
+                    os << m.row(r) << (r + 1 < DimH ? ";" : "");
+                }
+                return os << ']';
+            }
         };
+
+    // Typedefs for common use cases.
+    using Matrix3 = Matrix<3, 3, double>;
+    using Matrix4 = Matrix<4, 4, double>;
+    using Matrix3f = Matrix<3, 3, float>;
+    using Matrix4f = Matrix<4, 4, float>;
 } // namespace Geometry
 
 
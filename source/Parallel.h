@@ -0,0 +1,191 @@
+/**
+ * @file Parallel.h
+ * @brief Minimal fork-join helpers used by the batched geometry kernels.
+ *
+ * Work is split into contiguous, deterministic chunks: for a given element count and
+ * thread count, chunk `t` always covers the same index range. Kernels that touch the
+ * same data in several passes therefore keep each chunk on the same worker index.
+ *
+ * Batched algorithms also take an execution policy (`execution::seq`, `execution::par`, or
+ * the standard `std::execution` ones once StdExecution.h is included) and choose the thread
+ * count themselves: never more threads than give each one `min_thread_work_ns` of work, so
+ * small inputs stay on the calling thread.
+ * Requires C++20
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Geometry {
+    /// @brief Number of worker threads used when the caller does not specify one.
+    inline unsigned int default_thread_count() {
+        const auto hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 1u : hw;
+    }
+
+    /**
+     * @brief Half-open index range [begin, end) of chunk `chunk` out of `chunk_count`.
+     * @note The first `count % chunk_count` chunks get one extra element.
+     */
+    constexpr std::pair<std::size_t, std::size_t> chunk_range(std::size_t count,
+                                                              std::size_t chunk,
+                                                              std::size_t chunk_count) {
+        const auto base = count / chunk_count;
+        const auto extra = count % chunk_count;
+        const auto begin = chunk * base + std::min(chunk, extra);
+        const auto end = begin + base + (chunk < extra ? 1 : 0);
+        return {begin, end};
+    }
+
+    /**
+     * @brief Run `fn(begin, end, thread_index)` over `count` elements split across threads.
+     *
+     * The calling thread processes chunk 0, so `threads == 1` never spawns anything.
+     * Returns once every chunk is done.
+     *
+     * @param count Number of elements to process.
+     * @param fn Callable invoked as fn(std::size_t begin, std::size_t end, unsigned int thread_index).
+     * @param threads Number of chunks / threads (clamped to [1, count]).
+     */
+    template<typename Fn>
+    void parallel_for(std::size_t count, Fn &&fn, unsigned int threads = default_thread_count()) {
+        if (count == 0) {
+            return;
+        }
+        const auto chunks = static_cast<unsigned int>(std::clamp<std::size_t>(threads, 1, count));
+
+        std::vector<std::jthread> workers;
+        workers.reserve(chunks - 1);
+        for (unsigned int t = 1; t < chunks; ++t) {
+            const auto [begin, end] = chunk_range(count, t, chunks);
+            workers.emplace_back([&fn, begin, end, t] { fn(begin, end, t); });
+        }
+        const auto [begin, end] = chunk_range(count, 0, chunks);
+        fn(begin, end, 0u);
+        // std::jthread joins on destruction.
+    }
+
+    /**
+     * @brief Execution policies of the batched algorithms.
+     *
+     * The batched kernels vectorize on their own, so `par_unseq` is `par`.
+     */
+    namespace execution {
+        /// @brief Run on the calling thread.
+        struct SequencedPolicy {
+        };
+
+        /// @brief Split the work across threads, but not into pieces too small to pay for a thread.
+        struct ParallelPolicy {
+            /// Maximum number of threads, 0 for `default_thread_count()`.
+            unsigned int threads = 0;
+            /// Minimum number of elements per thread, 0 for the threshold of the algorithm.
+            std::size_t grain = 0;
+        };
+
+        inline constexpr SequencedPolicy seq{};
+        inline constexpr ParallelPolicy par{};
+        inline constexpr ParallelPolicy par_unseq{};
+    } // namespace execution
+
+    /**
+     * @brief Whether `P` is an execution policy, and whether it may use several threads.
+     *
+     * Specialized for the `Geometry::execution` policies here, and for the `std::execution`
+     * ones in StdExecution.h, which is opt-in: with libstdc++, <execution> needs TBB at link
+     * time when TBB is installed.
+     */
+    template<typename P>
+    struct ExecutionPolicyTraits {
+        static constexpr bool is_policy = false;
+        static constexpr bool parallel = false;
+    };
+
+    template<>
+    struct ExecutionPolicyTraits<execution::SequencedPolicy> {
+        static constexpr bool is_policy = true;
+        static constexpr bool parallel = false;
+    };
+
+    template<>
+    struct ExecutionPolicyTraits<execution::ParallelPolicy> {
+        static constexpr bool is_policy = true;
+        static constexpr bool parallel = true;
+    };
+
+    /// @brief A policy with `ExecutionPolicyTraits`.
+    template<typename P>
+    concept ExecutionPolicy = ExecutionPolicyTraits<std::remove_cvref_t<P>>::is_policy;
+
+    /**
+     * @brief Least work worth a thread, in nanoseconds.
+     * @note Starting and joining a std::jthread takes about 15 us (g++ 12, Linux), so a thread
+     *       given 100 us of work spends under 15% of it on overhead.
+     */
+    inline constexpr double min_thread_work_ns = 100'000;
+
+    /**
+     * @brief Estimated cost of one element of the batched kernels, in ns, to size their pieces.
+     *
+     * Rounded estimates for Vector3f on one core (g++ 12 -O3, SSE2), not exact figures: they
+     * only decide how many threads get `min_thread_work_ns` of work, so being off by 2x moves
+     * the thread count by 2x at most. `bench costs` (bench/Costs.cpp) measures each of them.
+     */
+    namespace element_cost_ns {
+        /// `transform`, and the key and permutation passes of `sort_by_key` (VectorAlgorithms.h).
+        inline constexpr double transform = 1.0;
+        inline constexpr double reduce = 1.0;
+        inline constexpr double normalize = 4.0;
+        /// Per element and per level of `sort_by_key` (log2 of the size), keys and moves included.
+        inline constexpr double sort = 9.0;
+        /// The span overloads of `Transform3` (Transform3.h).
+        inline constexpr double transform3 = 1.5;
+        /// `encode_octahedral` and `decode_octahedral` (Quantize.h).
+        inline constexpr double encode_octahedral = 5.0;
+        inline constexpr double decode_octahedral = 4.0;
+        /// `materialize` (VectorViews.h): the transposes of the chunked loop, then each stage.
+        inline constexpr double pipeline_transpose = 1.0;
+        inline constexpr double pipeline_stage = 1.0;
+    } // namespace element_cost_ns
+
+    /**
+     * @brief Number of threads `policy` runs `count` elements costing about `ns_per_element` on.
+     *
+     * 1 for sequenced policies. Parallel policies get at most their thread limit, and each
+     * thread gets at least their grain or, by default, `min_thread_work_ns` of work.
+     */
+    template<ExecutionPolicy Policy>
+    [[nodiscard]] unsigned int policy_thread_count(const Policy &policy, std::size_t count, double ns_per_element) {
+        using P = std::remove_cvref_t<Policy>;
+        if constexpr (!ExecutionPolicyTraits<P>::parallel) {
+            return 1;
+        } else {
+            execution::ParallelPolicy parallel;
+            if constexpr (std::is_same_v<P, execution::ParallelPolicy>) {
+                parallel = policy;
+            }
+            const auto max_threads = parallel.threads == 0 ? default_thread_count() : parallel.threads;
+            const auto grain = parallel.grain != 0
+                                   ? parallel.grain
+                                   : static_cast<std::size_t>(std::ceil(min_thread_work_ns / ns_per_element));
+            return static_cast<unsigned int>(std::clamp<std::size_t>(count / std::max<std::size_t>(grain, 1), 1,
+                                                                     max_threads));
+        }
+    }
+
+    /// @brief `parallel_for` on the number of threads `policy_thread_count` chooses.
+    template<ExecutionPolicy Policy, typename Fn>
+    void parallel_for(const Policy &policy, std::size_t count, double ns_per_element, Fn &&fn) {
+        parallel_for(count, std::forward<Fn>(fn), policy_thread_count(policy, count, ns_per_element));
+    }
+} // namespace Geometry
+
+#endif // PARALLEL_H
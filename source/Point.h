@@ -0,0 +1,282 @@
+/**
+ * @file Point.h
+ * @brief Affine point and direction types over `Vector` storage.
+ *
+ * `Point` is a position and `Direction` a displacement. Only the operations that make sense
+ * for each compile: point - point = direction, point ± direction = point, directions form a
+ * vector space, and points have no sum or scaling. Transforms overload on the two types, so
+ * the translation (w = 1 in homogeneous form) is applied to points and skipped for
+ * directions without the caller choosing the function.
+ * Requires C++20
+ */
+
+#ifndef POINT_H
+#define POINT_H
+
+#include <cassert>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+
+#include "Matrix.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /**
+     * @class Direction
+     * @brief A displacement between points (w = 0 in homogeneous form).
+     *
+     * @tparam Dim The dimension.
+     * @tparam T The scalar type. Must be arithmetic.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_arithmetic_v<T>
+    class Direction {
+    private:
+        Vector<Dim, T> _v;
+
+    public:
+        /// @brief Default constructor gives the zero direction.
+        constexpr Direction() = default;
+
+        constexpr explicit Direction(const Vector<Dim, T> &v) : _v(v) {
+        }
+
+        /// @brief Constructor with Dim components.
+        template<typename... Args>
+            requires (sizeof...(Args) == Dim && (std::is_arithmetic_v<std::remove_cvref_t<Args>> && ...))
+        constexpr explicit Direction(Args &&... args) : _v(static_cast<T>(std::forward<Args>(args))...) {
+        }
+
+        /// @brief Components as a plain vector.
+        [[nodiscard]] constexpr const Vector<Dim, T> &vector() const {
+            return _v;
+        }
+
+        constexpr const T &operator[](std::size_t index) const {
+            return _v[index];
+        }
+
+        constexpr T &operator[](std::size_t index) {
+            return _v[index];
+        }
+
+        [[nodiscard]] constexpr Direction operator+(const Direction &other) const {
+            return Direction(_v + other._v);
+        }
+
+        [[nodiscard]] constexpr Direction operator-(const Direction &other) const {
+            return Direction(_v - other._v);
+        }
+
+        [[nodiscard]] constexpr Direction operator-() const {
+            return Direction(_v * T(-1));
+        }
+
+        [[nodiscard]] constexpr Direction operator*(T scalar) const {
+            return Direction(_v * scalar);
+        }
+
+        [[nodiscard]] friend constexpr Direction operator*(T scalar, const Direction &d) {
+            return d * scalar;
+        }
+
+        [[nodiscard]] constexpr Direction operator/(T scalar) const {
+            return Direction(_v / scalar);
+        }
+
+        Direction &operator+=(const Direction &other) {
+            return *this = *this + other;
+        }
+
+        Direction &operator-=(const Direction &other) {
+            return *this = *this - other;
+        }
+
+        Direction &operator*=(T scalar) {
+            return *this = *this * scalar;
+        }
+
+        [[nodiscard]] constexpr T dot(const Direction &other) const {
+            return _v.dot(other._v);
+        }
+
+        [[nodiscard]] constexpr Direction cross(const Direction &other) const requires (Dim == 3) {
+            return Direction(_v.cross(other._v));
+        }
+
+        /// @brief 2D cross product a_x b_y - a_y b_x.
+        [[nodiscard]] constexpr T perp_dot(const Direction &other) const requires (Dim == 2) {
+            return _v.perp_dot(other._v);
+        }
+
+        /// @brief The direction rotated by +90 degrees.
+        [[nodiscard]] constexpr Direction perp() const requires (Dim == 2) {
+            return Direction(_v.perp());
+        }
+
+        [[nodiscard]] constexpr T squared_mag() const {
+            return _v.squared_mag();
+        }
+
+        [[nodiscard]] auto magnitude() const {
+            return _v.magnitude();
+        }
+
+        /// @brief Unit direction (must be non-zero).
+        [[nodiscard]] auto normalized() const requires std::is_floating_point_v<T> {
+            return _v.normalized();
+        }
+
+        constexpr bool operator==(const Direction &other) const {
+            return _v == other._v;
+        }
+
+        /// @brief Pretty print a direction.
+        friend std::ostream &operator<<(std::ostream &os, const Direction &d) {
+            os << "Direction" << Dim << '[';
+            for (auto i = 0u; i < Dim; ++i) {
+                os << d[i] << (i + 1 < Dim ? ';' : ']');
+            }
+            return os;
+        }
+    };
+
+    /**
+     * @class Point
+     * @brief A position (w = 1 in homogeneous form).
+     *
+     * @tparam Dim The dimension.
+     * @tparam T The scalar type. Must be arithmetic.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_arithmetic_v<T>
+    class Point {
+    private:
+        Vector<Dim, T> _v;
+
+    public:
+        /// @brief Default constructor gives the origin.
+        constexpr Point() = default;
+
+        /// @brief Point at `v` from the origin.
+        constexpr explicit Point(const Vector<Dim, T> &v) : _v(v) {
+        }
+
+        /// @brief Constructor with Dim coordinates.
+        template<typename... Args>
+            requires (sizeof...(Args) == Dim && (std::is_arithmetic_v<std::remove_cvref_t<Args>> && ...))
+        constexpr explicit Point(Args &&... args) : _v(static_cast<T>(std::forward<Args>(args))...) {
+        }
+
+        /// @brief Coordinates as a plain vector (the position relative to the origin).
+        [[nodiscard]] constexpr const Vector<Dim, T> &vector() const {
+            return _v;
+        }
+
+        constexpr const T &operator[](std::size_t index) const {
+            return _v[index];
+        }
+
+        constexpr T &operator[](std::size_t index) {
+            return _v[index];
+        }
+
+        /// @brief Displacement from `other` to this point.
+        [[nodiscard]] constexpr Direction<Dim, T> operator-(const Point &other) const {
+            return Direction<Dim, T>(_v - other._v);
+        }
+
+        [[nodiscard]] constexpr Point operator+(const Direction<Dim, T> &d) const {
+            return Point(_v + d.vector());
+        }
+
+        [[nodiscard]] friend constexpr Point operator+(const Direction<Dim, T> &d, const Point &p) {
+            return p + d;
+        }
+
+        [[nodiscard]] constexpr Point operator-(const Direction<Dim, T> &d) const {
+            return Point(_v - d.vector());
+        }
+
+        Point &operator+=(const Direction<Dim, T> &d) {
+            return *this = *this + d;
+        }
+
+        Point &operator-=(const Direction<Dim, T> &d) {
+            return *this = *this - d;
+        }
+
+        constexpr bool operator==(const Point &other) const {
+            return _v == other._v;
+        }
+
+        /// @brief Pretty print a point.
+        friend std::ostream &operator<<(std::ostream &os, const Point &p) {
+            os << "Point" << Dim << '[';
+            for (auto i = 0u; i < Dim; ++i) {
+                os << p[i] << (i + 1 < Dim ? ';' : ']');
+            }
+            return os;
+        }
+    };
+
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr T squared_distance(const Point<Dim, T> &a, const Point<Dim, T> &b) {
+        return (a - b).squared_mag();
+    }
+
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] auto distance(const Point<Dim, T> &a, const Point<Dim, T> &b) {
+        return (a - b).magnitude();
+    }
+
+    /// @brief Affine combination a + (b - a) t; the only way to "add" two points.
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] constexpr Point<Dim, T> lerp(const Point<Dim, T> &a, const Point<Dim, T> &b, T t) {
+        return a + (b - a) * t;
+    }
+
+    /// @brief Orientation of the triangle (a, b, c): 1 counter-clockwise, -1 clockwise, 0 collinear.
+    template<typename T>
+    [[nodiscard]] constexpr int orientation(const Point<2, T> &a, const Point<2, T> &b, const Point<2, T> &c) {
+        return orientation(a.vector(), b.vector(), c.vector());
+    }
+
+    /**
+     * @brief Transform a point by a 4x4 homogeneous matrix (w = 1).
+     * @note Divides by the resulting w, so projective matrices work too.
+     */
+    template<typename T>
+    [[nodiscard]] constexpr Point<3, T> transform(const Matrix<4, 4, T> &m, const Point<3, T> &p) {
+        Vector<4, T> h;
+        for (auto r = 0u; r < 4; ++r) {
+            h[r] = m(r, 0) * p[0] + m(r, 1) * p[1] + m(r, 2) * p[2] + m(r, 3);
+        }
+        assert(h[3] != 0 && "Point transformed to infinity.");
+        return Point<3, T>(h[0] / h[3], h[1] / h[3], h[2] / h[3]);
+    }
+
+    /// @brief Transform a direction by a 4x4 homogeneous matrix (w = 0): the upper 3x3 only.
+    template<typename T>
+    [[nodiscard]] constexpr Direction<3, T> transform(const Matrix<4, 4, T> &m, const Direction<3, T> &d) {
+        Direction<3, T> result;
+        for (auto r = 0u; r < 3; ++r) {
+            result[r] = m(r, 0) * d[0] + m(r, 1) * d[1] + m(r, 2) * d[2];
+        }
+        return result;
+    }
+
+    // Typedefs for common use cases.
+    using Point2 = Point<2, double>;
+    using Point3 = Point<3, double>;
+    using Point2f = Point<2, float>;
+    using Point3f = Point<3, float>;
+    using Direction2 = Direction<2, double>;
+    using Direction3 = Direction<3, double>;
+    using Direction2f = Direction<2, float>;
+    using Direction3f = Direction<3, float>;
+} // namespace Geometry
+
+#endif // POINT_H
@@ -0,0 +1,390 @@
+/**
+ * @file PoissonDisk.h
+ * @brief Blue-noise point sets by Poisson-disk sampling (Bridson) in any dimension.
+ *
+ * Points are at least `radius` apart, and the set is maximal except for pockets narrower
+ * than 1/256 of a cell: once Bridson's growth stops, every grid cell still empty is searched
+ * by subdivision for a position that fits, and each one found seeds a new growth.
+ *
+ * A background grid with cell size radius / sqrt(Dim) holds at most one point per cell and
+ * stores the point itself, so a distance check reads a small block of neighbouring cells
+ * without chasing indices into the output array.
+ *
+ * `poisson_disk_tiled` splits the grid into tiles processed in 2^Dim phases: tiles of a
+ * phase have the same parity along every axis, so they never touch the same cells and
+ * run in parallel. Each tile draws from its own random stream, which makes the result
+ * independent of the thread count.
+ * Requires C++20
+ */
+
+#ifndef POISSONDISK_H
+#define POISSONDISK_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Parallel.h"
+#include "Random.h"
+#include "Vector.h"
+
+namespace Geometry {
+    namespace detail {
+        /// Background grid of a Poisson-disk sampler; cells hold at most one point.
+        template<unsigned int Dim, typename T>
+        class PoissonGrid {
+        public:
+            using Cell = std::array<std::int64_t, Dim>;
+
+            PoissonGrid(const Vector<Dim, T> &min, const Vector<Dim, T> &max, T radius)
+                : _min(min), _max(max), _radius2(radius * radius),
+                  _cell(radius / std::sqrt(static_cast<T>(Dim))),
+                  // Cells within `radius` of a cell are at most ceil(sqrt(Dim)) cells away.
+                  _reach(static_cast<std::int64_t>(std::ceil(std::sqrt(static_cast<T>(Dim))))) {
+                std::size_t count = 1;
+                for (auto d = 0u; d < Dim; ++d) {
+                    assert(max[d] > min[d] && "Empty sampling box.");
+                    _dims[d] = std::max<std::int64_t>(1, static_cast<std::int64_t>(std::ceil((max[d] - min[d]) / _cell)));
+                    count *= static_cast<std::size_t>(_dims[d]);
+                }
+                _points.resize(count);
+                _occupied.resize(count, 0);
+            }
+
+            [[nodiscard]] const Cell &dims() const {
+                return _dims;
+            }
+
+            [[nodiscard]] std::int64_t reach() const {
+                return _reach;
+            }
+
+            [[nodiscard]] const Vector<Dim, T> &min() const {
+                return _min;
+            }
+
+            [[nodiscard]] T cell_size() const {
+                return _cell;
+            }
+
+            [[nodiscard]] bool occupied(const Cell &cell) const {
+                return _occupied[index(cell)] != 0;
+            }
+
+            [[nodiscard]] Cell cell_of(const Vector<Dim, T> &p) const {
+                Cell cell;
+                for (auto d = 0u; d < Dim; ++d) {
+                    cell[d] = std::clamp<std::int64_t>(static_cast<std::int64_t>((p[d] - _min[d]) / _cell), 0, _dims[d] - 1);
+                }
+                return cell;
+            }
+
+            /// True if `p` is inside the box and at least `radius` away from every stored point.
+            [[nodiscard]] bool fits(const Vector<Dim, T> &p) const {
+                for (auto d = 0u; d < Dim; ++d) {
+                    if (p[d] < _min[d] || p[d] >= _max[d]) {
+                        return false;
+                    }
+                }
+                return all_neighbours(cell_of(p), [&](const Vector<Dim, T> &q) {
+                    return (q - p).squared_mag() >= _radius2;
+                });
+            }
+
+            /// True if a single stored point is closer than `radius` to all of [lo, hi]: nothing fits there.
+            [[nodiscard]] bool covers(const Vector<Dim, T> &lo, const Vector<Dim, T> &hi) const {
+                return !all_neighbours(cell_of((lo + hi) * T(0.5)), [&](const Vector<Dim, T> &q) {
+                    // The disk is convex: it holds the box if it holds the farthest corner.
+                    T farthest2 = 0;
+                    for (auto d = 0u; d < Dim; ++d) {
+                        const auto e = std::max(std::abs(q[d] - lo[d]), std::abs(q[d] - hi[d]));
+                        farthest2 += e * e;
+                    }
+                    return farthest2 >= _radius2;
+                });
+            }
+
+            void insert(const Vector<Dim, T> &p) {
+                const auto i = index(cell_of(p));
+                assert(!_occupied[i] && "Poisson grid cell already taken.");
+                _points[i] = p;
+                _occupied[i] = 1;
+            }
+
+        private:
+            /// True if `test(point)` holds for every stored point within `reach` cells of `center`.
+            template<typename Test>
+            [[nodiscard]] bool all_neighbours(const Cell &center, Test &&test) const {
+                Cell lo, hi, cell;
+                for (auto d = 0u; d < Dim; ++d) {
+                    lo[d] = std::max<std::int64_t>(0, center[d] - _reach);
+                    hi[d] = std::min<std::int64_t>(_dims[d] - 1, center[d] + _reach);
+                }
+                cell = lo;
+                while (true) {
+                    const auto i = index(cell);
+                    if (_occupied[i] && !test(_points[i])) {
+                        return false;
+                    }
+                    // Odometer over the neighbourhood block.
+                    unsigned int d = 0;
+                    while (d < Dim && cell[d] == hi[d]) {
+                        cell[d] = lo[d];
+                        ++d;
+                    }
+                    if (d == Dim) {
+                        return true;
+                    }
+                    ++cell[d];
+                }
+            }
+
+            [[nodiscard]] std::size_t index(const Cell &cell) const {
+                std::size_t i = 0;
+                for (auto d = Dim; d-- > 0;) {
+                    i = i * static_cast<std::size_t>(_dims[d]) + static_cast<std::size_t>(cell[d]);
+                }
+                return i;
+            }
+
+            Vector<Dim, T> _min, _max;
+            T _radius2;
+            T _cell;
+            std::int64_t _reach;
+            Cell _dims{};
+            std::vector<Vector<Dim, T>> _points;
+            std::vector<std::uint8_t> _occupied;
+        };
+
+        /**
+         * Bridson's algorithm restricted to the box [lo, hi): grows the set from an active
+         * point until no active point can place a new neighbour, then seeds a new growth in
+         * any empty cell of the box where a position still fits. The box may already be
+         * partly covered by neighbouring boxes, and growth alone leaves pockets it cannot
+         * reach from the points around them.
+         */
+        template<unsigned int Dim, typename T>
+        void bridson_fill(PoissonGrid<Dim, T> &grid, const Vector<Dim, T> &lo, const Vector<Dim, T> &hi,
+                          T radius, unsigned int attempts, Xoshiro256pp &rng, std::vector<Vector<Dim, T>> &out) {
+            using Cell = typename PoissonGrid<Dim, T>::Cell;
+            const auto uniform = [&rng] {
+                return to_unit<T>(rng());
+            };
+            const auto inside = [&](const Vector<Dim, T> &p) {
+                for (auto d = 0u; d < Dim; ++d) {
+                    if (p[d] < lo[d] || p[d] >= hi[d]) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            std::vector<std::size_t> active;
+            const auto place = [&](const Vector<Dim, T> &p) {
+                if (!inside(p) || !grid.fits(p)) {
+                    return false;
+                }
+                grid.insert(p);
+                active.push_back(out.size());
+                out.push_back(p);
+                return true;
+            };
+            const auto grow = [&] {
+                while (!active.empty()) {
+                    const auto slot = std::min(static_cast<std::size_t>(uniform() * static_cast<T>(active.size())),
+                                               active.size() - 1);
+                    const auto origin = out[active[slot]];
+                    bool placed = false;
+                    for (unsigned int k = 0; k < attempts && !placed; ++k) {
+                        // Uniform in the shell [radius, 2 radius] by rejection from its bounding cube.
+                        Vector<Dim, T> offset;
+                        T length2;
+                        do {
+                            for (auto d = 0u; d < Dim; ++d) {
+                                offset[d] = (uniform() * T(4) - T(2)) * radius;
+                            }
+                            length2 = offset.squared_mag();
+                        } while (length2 < radius * radius || length2 > T(4) * radius * radius);
+                        placed = place(origin + offset);
+                    }
+                    if (!placed) {
+                        // Swap-remove the exhausted point.
+                        active[slot] = active.back();
+                        active.pop_back();
+                    }
+                }
+            };
+
+            // Empty cells of the box, visited in random order so seeds do not sweep the box.
+            const auto first = grid.cell_of(lo), last = grid.cell_of(hi);
+            std::vector<Cell> empty;
+            for (auto cell = first;;) {
+                if (!grid.occupied(cell)) {
+                    empty.push_back(cell);
+                }
+                unsigned int d = 0;
+                while (d < Dim && cell[d] == last[d]) {
+                    cell[d] = first[d];
+                    ++d;
+                }
+                if (d == Dim) {
+                    break;
+                }
+                ++cell[d];
+            }
+            for (auto i = empty.size(); i > 1; --i) {
+                std::swap(empty[i - 1], empty[static_cast<std::size_t>(rng() % i)]);
+            }
+
+            // Each empty cell is searched by subdivision: a box takes one uniform candidate, is
+            // dropped once a single point covers it, and is otherwise split in 2^Dim halves.
+            // Uncovered pockets down to 1/2^seed_depth of a cell are found.
+            constexpr unsigned int seed_depth = 8;
+            struct Box {
+                Vector<Dim, T> lo, hi;
+                unsigned int depth;
+            };
+            std::vector<Box> boxes;
+            for (const auto &cell: empty) {
+                // Part of the cell inside the box; cells on the far edge may not overlap it.
+                Box box{lo, hi, 0};
+                bool overlaps = true;
+                for (auto d = 0u; d < Dim; ++d) {
+                    const auto start = grid.min()[d] + static_cast<T>(cell[d]) * grid.cell_size();
+                    box.lo[d] = std::max(lo[d], start);
+                    box.hi[d] = std::min(hi[d], start + grid.cell_size());
+                    overlaps = overlaps && box.lo[d] < box.hi[d];
+                }
+                if (overlaps) {
+                    boxes.push_back(box);
+                }
+                // A point in the cell covers all of it (the cell diagonal is `radius`).
+                while (!boxes.empty() && !grid.occupied(cell)) {
+                    const auto current = boxes.back();
+                    boxes.pop_back();
+                    if (grid.covers(current.lo, current.hi)) {
+                        continue;
+                    }
+                    Vector<Dim, T> p;
+                    for (auto d = 0u; d < Dim; ++d) {
+                        p[d] = current.lo[d] + (current.hi[d] - current.lo[d]) * uniform();
+                    }
+                    if (place(p)) {
+                        grow();
+                    } else if (current.depth < seed_depth) {
+                        for (unsigned int half = 0; half < (1u << Dim); ++half) {
+                            Box child{current.lo, current.hi, current.depth + 1};
+                            for (auto d = 0u; d < Dim; ++d) {
+                                const auto middle = (current.lo[d] + current.hi[d]) * T(0.5);
+                                (half >> d & 1 ? child.lo[d] : child.hi[d]) = middle;
+                            }
+                            boxes.push_back(child);
+                        }
+                    }
+                }
+                boxes.clear();
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @brief Poisson-disk samples of the box [min, max).
+     *
+     * @param radius Minimum distance between samples.
+     * @param seed Random seed; equal seeds give equal point sets.
+     * @param attempts Candidates tried around each active point (Bridson's k).
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] std::vector<Vector<Dim, T>> poisson_disk(const Vector<Dim, T> &min, const Vector<Dim, T> &max,
+                                                           T radius, std::uint64_t seed, unsigned int attempts = 30) {
+        assert(radius > 0 && "Poisson-disk radius must be positive.");
+        detail::PoissonGrid<Dim, T> grid(min, max, radius);
+        Xoshiro256pp rng(seed);
+        std::vector<Vector<Dim, T>> points;
+        detail::bridson_fill(grid, min, max, radius, attempts, rng, points);
+        return points;
+    }
+
+    /**
+     * @brief Poisson-disk samples of the box [min, max), tiled and filled in parallel.
+     *
+     * The output is deterministic for a given seed and tile size (whatever `threads`),
+     * but differs from `poisson_disk`. Points are grouped tile by tile.
+     *
+     * @param tile_cells Tile edge in grid cells (raised above the neighbourhood reach if smaller).
+     * @param threads Worker threads per phase.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] std::vector<Vector<Dim, T>> poisson_disk_tiled(const Vector<Dim, T> &min,
+                                                                 const Vector<Dim, T> &max,
+                                                                 T radius, std::uint64_t seed,
+                                                                 unsigned int threads = default_thread_count(),
+                                                                 std::size_t tile_cells = 32,
+                                                                 unsigned int attempts = 30) {
+        assert(radius > 0 && "Poisson-disk radius must be positive.");
+        detail::PoissonGrid<Dim, T> grid(min, max, radius);
+        // Tiles wider than the neighbourhood reach: reads and (rounded) writes stay in adjacent
+        // tiles, which always belong to another phase.
+        const auto tile = std::max<std::int64_t>(static_cast<std::int64_t>(tile_cells), grid.reach() + 1);
+        const auto tile_size = static_cast<T>(tile) * grid.cell_size();
+
+        std::array<std::int64_t, Dim> tiles;
+        std::size_t tile_count = 1;
+        for (auto d = 0u; d < Dim; ++d) {
+            tiles[d] = (grid.dims()[d] + tile - 1) / tile;
+            tile_count *= static_cast<std::size_t>(tiles[d]);
+        }
+
+        const auto tile_coordinates = [&](std::size_t t) {
+            std::array<std::int64_t, Dim> coordinates;
+            for (auto d = 0u; d < Dim; ++d) {
+                coordinates[d] = static_cast<std::int64_t>(t % static_cast<std::size_t>(tiles[d]));
+                t /= static_cast<std::size_t>(tiles[d]);
+            }
+            return coordinates;
+        };
+
+        std::vector<std::vector<Vector<Dim, T>>> per_tile(tile_count);
+        for (unsigned int phase = 0; phase < (1u << Dim); ++phase) {
+            std::vector<std::size_t> phase_tiles;
+            for (std::size_t t = 0; t < tile_count; ++t) {
+                const auto coordinates = tile_coordinates(t);
+                unsigned int parity = 0;
+                for (auto d = 0u; d < Dim; ++d) {
+                    parity |= static_cast<unsigned int>(coordinates[d] & 1) << d;
+                }
+                if (parity == phase) {
+                    phase_tiles.push_back(t);
+                }
+            }
+
+            parallel_for(phase_tiles.size(), [&](std::size_t begin, std::size_t end, unsigned int) {
+                for (auto k = begin; k < end; ++k) {
+                    const auto t = phase_tiles[k];
+                    const auto coordinates = tile_coordinates(t);
+                    Vector<Dim, T> lo, hi;
+                    for (auto d = 0u; d < Dim; ++d) {
+                        lo[d] = min[d] + static_cast<T>(coordinates[d]) * tile_size;
+                        hi[d] = std::min(max[d], lo[d] + tile_size);
+                    }
+                    const auto stream = Philox4x32(seed)(t);
+                    Xoshiro256pp tile_rng((std::uint64_t{stream[0]} << 32) | stream[1]);
+                    detail::bridson_fill(grid, lo, hi, radius, attempts, tile_rng, per_tile[t]);
+                }
+            }, threads);
+        }
+
+        std::vector<Vector<Dim, T>> points;
+        for (const auto &tile_points: per_tile) {
+            points.insert(points.end(), tile_points.begin(), tile_points.end());
+        }
+        return points;
+    }
+} // namespace Geometry
+
+#endif // POISSONDISK_H
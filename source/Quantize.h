@@ -0,0 +1,254 @@
+/**
+ * @file Quantize.h
+ * @brief Compact encodings for unit vectors and bounded positions.
+ *
+ * - Octahedral encoding maps a unit vector onto the octahedron |x|+|y|+|z| = 1, unfolds
+ *   it onto the [-1, 1]^2 square and stores both coordinates on Bits/2 bits. Measured
+ *   maximum angular error (round-to-nearest encode, uniformly sampled directions):
+ *     - 16 bits (8 + 8):   0.95 degrees
+ *     - 24 bits (12 + 12): 0.059 degrees
+ *     - 32 bits (16 + 16): 0.0037 degrees
+ * - Position quantization stores each component of a point inside a known box on 16 bits.
+ *   The error per component is at most (max - min) / (2 * 65535), plus float rounding.
+ *
+ * A `Vector3f` takes 12 bytes; the encodings take 2, 3, 4 (unit vectors) and 6 (positions).
+ * The batched overloads are branch-free loops over contiguous spans so the compiler can
+ * vectorize them: octahedral coordinates are rounded with the float magic-number trick
+ * instead of `std::lround`, and the hemisphere fold is a bit-mask select. The octahedral
+ * decode also needs -fno-math-errno, as std::sqrt otherwise keeps an errno branch.
+ * Requires C++20
+ */
+
+#ifndef QUANTIZE_H
+#define QUANTIZE_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "FastMath.h"
+#include "Parallel.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /**
+     * @brief Octahedral-encoded unit vector on `Bits` bits (16, 24 or 32).
+     *
+     * Both octahedral coordinates are stored as unsigned integers of Bits/2 bits;
+     * `u` is in the low half.
+     */
+    template<unsigned int Bits>
+        requires (Bits == 16 || Bits == 24 || Bits == 32)
+    struct OctEncoded {
+        using storage_type = std::conditional_t<Bits == 16, std::uint16_t,
+            std::conditional_t<Bits == 24, std::array<std::uint8_t, 3>, std::uint32_t>>;
+
+        static constexpr unsigned int component_bits = Bits / 2;
+        static constexpr std::uint32_t component_max = (std::uint32_t{1} << component_bits) - 1;
+
+        storage_type bits{};
+
+        [[nodiscard]] constexpr std::uint32_t packed() const {
+            if constexpr (Bits == 24) {
+                return bits[0] | (std::uint32_t{bits[1]} << 8) | (std::uint32_t{bits[2]} << 16);
+            } else {
+                return bits;
+            }
+        }
+
+        constexpr void pack(std::uint32_t u, std::uint32_t v) {
+            const auto value = u | (v << component_bits);
+            if constexpr (Bits == 24) {
+                bits = {
+                    static_cast<std::uint8_t>(value), static_cast<std::uint8_t>(value >> 8),
+                    static_cast<std::uint8_t>(value >> 16)
+                };
+            } else {
+                bits = static_cast<storage_type>(value);
+            }
+        }
+
+        [[nodiscard]] constexpr std::uint32_t u() const {
+            return packed() & component_max;
+        }
+
+        [[nodiscard]] constexpr std::uint32_t v() const {
+            return packed() >> component_bits;
+        }
+
+        constexpr bool operator==(const OctEncoded &other) const = default;
+    };
+
+    using OctNormal16 = OctEncoded<16>;
+    using OctNormal24 = OctEncoded<24>;
+    using OctNormal32 = OctEncoded<32>;
+
+    namespace detail {
+        /// Octahedral encoding without checks or branches, shared by the scalar and span forms.
+        template<unsigned int Bits, typename T>
+        OctEncoded<Bits> encode_octahedral(const Vector<3, T> &n) {
+            const auto inv_l1 = T(1) / (std::abs(n[0]) + std::abs(n[1]) + std::abs(n[2]));
+            const auto px = n[0] * inv_l1;
+            const auto py = n[1] * inv_l1;
+            // Fold the lower hemisphere over the diagonals.
+            const auto lower = n[2] < 0;
+            const auto u = fastmath::blend(lower, std::copysign(T(1) - std::abs(py), px), px);
+            const auto v = fastmath::blend(lower, std::copysign(T(1) - std::abs(px), py), py);
+
+            // Both values are in [0, component_max], far below the limit of round_nearest.
+            constexpr auto scale = static_cast<T>(OctEncoded<Bits>::component_max) * T(0.5);
+            typename fastmath::detail::Constants<T>::Int iu, iv;
+            fastmath::detail::round_nearest(u * scale + scale, iu);
+            fastmath::detail::round_nearest(v * scale + scale, iv);
+            OctEncoded<Bits> encoded;
+            encoded.pack(static_cast<std::uint32_t>(iu), static_cast<std::uint32_t>(iv));
+            return encoded;
+        }
+
+        /// Octahedral decoding; the result is unit length, as the octahedron point is never zero.
+        template<typename T, unsigned int Bits>
+        Vector<3, T> decode_octahedral(const OctEncoded<Bits> &encoded) {
+            constexpr auto scale = T(2) / static_cast<T>(OctEncoded<Bits>::component_max);
+            const auto px = static_cast<T>(encoded.u()) * scale - T(1);
+            const auto py = static_cast<T>(encoded.v()) * scale - T(1);
+            const auto z = T(1) - std::abs(px) - std::abs(py);
+            // Unfold the lower hemisphere: t = max(-z, 0).
+            const auto t = std::max(-z, T(0));
+            const auto x = px - std::copysign(t, px);
+            const auto y = py - std::copysign(t, py);
+            const auto inv_length = T(1) / std::sqrt(x * x + y * y + z * z);
+            return Vector<3, T>(x * inv_length, y * inv_length, z * inv_length);
+        }
+    } // namespace detail
+
+    /**
+     * @brief Encode a unit vector with octahedral mapping.
+     * @warning `n` must be normalized; the result is undefined for the zero vector.
+     */
+    template<unsigned int Bits, typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] OctEncoded<Bits> encode_octahedral(const Vector<3, T> &n) {
+        assert(std::abs(n[0]) + std::abs(n[1]) + std::abs(n[2]) > 0 && "Cannot encode a zero vector.");
+        return detail::encode_octahedral<Bits>(n);
+    }
+
+    /// @brief Decode an octahedral-encoded unit vector (the result is normalized).
+    template<typename T = float, unsigned int Bits>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] UnitVector<3, T> decode_octahedral(const OctEncoded<Bits> &encoded) {
+        return UnitVector<3, T>::from_unit(detail::decode_octahedral<T>(encoded));
+    }
+
+    /// @brief Encode a span of unit vectors: out[i] = encode_octahedral(in[i]).
+    template<unsigned int Bits, typename T>
+    void encode_octahedral(std::span<const Vector<3, T>> in, std::span<OctEncoded<Bits>> out) {
+        assert(out.size() >= in.size() && "Output span is too small.");
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            out[i] = detail::encode_octahedral<Bits>(in[i]);
+        }
+    }
+
+    /// @brief Decode a span of octahedral-encoded unit vectors.
+    template<unsigned int Bits, typename T>
+    void decode_octahedral(std::span<const OctEncoded<Bits>> in, std::span<Vector<3, T>> out) {
+        assert(out.size() >= in.size() && "Output span is too small.");
+        for (std::size_t i = 0; i < in.size(); ++i) {
+            out[i] = detail::decode_octahedral<T>(in[i]);
+        }
+    }
+
+    /// @brief `encode_octahedral` over a span, split across threads as `policy` allows.
+    template<unsigned int Bits, ExecutionPolicy Policy, typename T>
+    void encode_octahedral(const Policy &policy, std::span<const Vector<3, T>> in, std::span<OctEncoded<Bits>> out) {
+        assert(out.size() >= in.size() && "Output span is too small.");
+        parallel_for(policy, in.size(), element_cost_ns::encode_octahedral, [&](std::size_t begin, std::size_t end, unsigned int) {
+            encode_octahedral<Bits>(in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+        });
+    }
+
+    /// @brief `decode_octahedral` over a span, split across threads as `policy` allows.
+    template<unsigned int Bits, ExecutionPolicy Policy, typename T>
+    void decode_octahedral(const Policy &policy, std::span<const OctEncoded<Bits>> in, std::span<Vector<3, T>> out) {
+        assert(out.size() >= in.size() && "Output span is too small.");
+        parallel_for(policy, in.size(), element_cost_ns::decode_octahedral, [&](std::size_t begin, std::size_t end, unsigned int) {
+            decode_octahedral(in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+        });
+    }
+
+    /// @brief A 3D position quantized on 16 bits per component.
+    struct QuantizedPosition {
+        std::array<std::uint16_t, 3> bits{};
+
+        constexpr bool operator==(const QuantizedPosition &other) const = default;
+    };
+
+    /**
+     * @class PositionQuantizer
+     * @brief Maps positions inside the box [min, max] to 16 bits per component.
+     *
+     * Positions outside the box are clamped. The reconstruction error per component is at
+     * most `max_error()[c]` = (max[c] - min[c]) / (2 * 65535), up to floating-point rounding.
+     */
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    class PositionQuantizer {
+    public:
+        static constexpr T levels = T(65535);
+
+        PositionQuantizer(const Vector<3, T> &min, const Vector<3, T> &max) : _min(min) {
+            for (auto c = 0u; c < 3; ++c) {
+                assert(max[c] > min[c] && "Quantization box must have a positive extent.");
+                _step[c] = (max[c] - min[c]) / levels;
+                _inv_step[c] = levels / (max[c] - min[c]);
+            }
+        }
+
+        [[nodiscard]] QuantizedPosition encode(const Vector<3, T> &p) const {
+            QuantizedPosition q;
+            for (auto c = 0u; c < 3; ++c) {
+                const auto scaled = std::clamp((p[c] - _min[c]) * _inv_step[c], T(0), levels);
+                q.bits[c] = static_cast<std::uint16_t>(scaled + T(0.5));
+            }
+            return q;
+        }
+
+        [[nodiscard]] Vector<3, T> decode(const QuantizedPosition &q) const {
+            Vector<3, T> p;
+            for (auto c = 0u; c < 3; ++c) {
+                p[c] = _min[c] + static_cast<T>(q.bits[c]) * _step[c];
+            }
+            return p;
+        }
+
+        void encode(std::span<const Vector<3, T>> in, std::span<QuantizedPosition> out) const {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = encode(in[i]);
+            }
+        }
+
+        void decode(std::span<const QuantizedPosition> in, std::span<Vector<3, T>> out) const {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = decode(in[i]);
+            }
+        }
+
+        /// @brief Worst-case absolute reconstruction error per component for points inside the box.
+        [[nodiscard]] Vector<3, T> max_error() const {
+            return _step * T(0.5);
+        }
+
+    private:
+        Vector<3, T> _min;
+        Vector<3, T> _step;
+        Vector<3, T> _inv_step;
+    };
+} // namespace Geometry
+
+#endif // QUANTIZE_H
@@ -0,0 +1,240 @@
+/**
+ * @file Quaternion.h
+ * @brief Unit quaternions for 3D rotations and dual quaternions for rigid transforms.
+ *
+ * Stored as (w, x, y, z) with w the scalar part. Rotations compose with `operator*`
+ * (q1 * q2 applies q2 first) and rotate vectors with `rotate()`.
+ * Requires C++20
+ */
+
+#ifndef QUATERNION_H
+#define QUATERNION_H
+
+#include <cassert>
+#include <cmath>
+#include <ostream>
+#include <type_traits>
+
+#include "Matrix.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /**
+     * @class Quaternion
+     * @brief A quaternion w + xi + yj + zk, used as a rotation when normalized.
+     *
+     * @tparam T The scalar type. Must be floating point.
+     */
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    class Quaternion {
+    private:
+        T _w;
+        Vector<3, T> _v;
+
+    public:
+        /// @brief Default constructor gives the identity rotation.
+        constexpr Quaternion() : _w(1), _v() {
+        }
+
+        constexpr Quaternion(T w, T x, T y, T z) : _w(w), _v(x, y, z) {
+        }
+
+        constexpr Quaternion(T w, const Vector<3, T> &v) : _w(w), _v(v) {
+        }
+
+        /**
+         * @brief Rotation of `angle` radians around `axis`.
+         * @param axis Rotation axis (must be non-zero, need not be normalized).
+         */
+        [[nodiscard]] static Quaternion from_axis_angle(const Vector<3, T> &axis, T angle) {
+            const auto half = angle * T(0.5);
+            return Quaternion(std::cos(half), axis.normalized() * std::sin(half));
+        }
+
+        /// @brief Rotation of `angle` radians around a unit `axis`, without renormalizing it.
+        [[nodiscard]] static Quaternion from_axis_angle(const UnitVector<3, T> &axis, T angle) {
+            const auto half = angle * T(0.5);
+            return Quaternion(std::cos(half), axis * std::sin(half));
+        }
+
+        [[nodiscard]] constexpr T w() const {
+            return _w;
+        }
+
+        /// @brief Vector (imaginary) part.
+        [[nodiscard]] constexpr const Vector<3, T> &vec() const {
+            return _v;
+        }
+
+        /**
+         * @brief Hamilton product: the rotation `other` followed by `this`.
+         */
+        [[nodiscard]] Quaternion operator*(const Quaternion &other) const {
+            return Quaternion(_w * other._w - _v.dot(other._v),
+                              other._v * _w + _v * other._w + _v.cross(other._v));
+        }
+
+        /// @brief Component-wise scaling.
+        [[nodiscard]] constexpr Quaternion operator*(T scalar) const {
+            return Quaternion(_w * scalar, _v * scalar);
+        }
+
+        /// @brief Component-wise sum (used for blending).
+        [[nodiscard]] constexpr Quaternion operator+(const Quaternion &other) const {
+            return Quaternion(_w + other._w, _v + other._v);
+        }
+
+        /// @brief 4D dot product of the components.
+        [[nodiscard]] constexpr T dot(const Quaternion &other) const {
+            return _w * other._w + _v.dot(other._v);
+        }
+
+        /// @brief Conjugate; the inverse rotation for unit quaternions.
+        [[nodiscard]] constexpr Quaternion conjugate() const {
+            return Quaternion(_w, _v * T(-1));
+        }
+
+        [[nodiscard]] T magnitude() const {
+            return std::sqrt(dot(*this));
+        }
+
+        /// @brief Return a unit-length copy.
+        [[nodiscard]] Quaternion normalized() const {
+            const auto mag = magnitude();
+            assert(mag > 0 && "Cannot normalize a zero quaternion.");
+            return *this * (T(1) / mag);
+        }
+
+        /**
+         * @brief Rotate a vector by this (unit) quaternion.
+         * @note Uses v' = v + w t + q.v x t with t = 2 q.v x v (15 multiplies).
+         */
+        [[nodiscard]] Vector<3, T> rotate(const Vector<3, T> &v) const {
+            const auto t = _v.cross(v) * T(2);
+            return v + t * _w + _v.cross(t);
+        }
+
+        /// @brief Rotate a unit vector; rotations keep the length, so the result stays a UnitVector.
+        [[nodiscard]] UnitVector<3, T> rotate(const UnitVector<3, T> &v) const {
+            return UnitVector<3, T>::from_unit(rotate(static_cast<const Vector<3, T> &>(v)));
+        }
+
+        /// @brief Equivalent 3x3 rotation matrix (for a unit quaternion).
+        [[nodiscard]] Matrix<3, 3, T> to_matrix() const {
+            const auto x = _v[0], y = _v[1], z = _v[2];
+            return Matrix<3, 3, T>(
+                T(1) - T(2) * (y * y + z * z), T(2) * (x * y - _w * z), T(2) * (x * z + _w * y),
+                T(2) * (x * y + _w * z), T(1) - T(2) * (x * x + z * z), T(2) * (y * z - _w * x),
+                T(2) * (x * z - _w * y), T(2) * (y * z + _w * x), T(1) - T(2) * (x * x + y * y)
+            );
+        }
+
+        /// @brief Rotation quaternion of an orthonormal 3x3 matrix (Shepperd's method).
+        [[nodiscard]] static Quaternion from_matrix(const Matrix<3, 3, T> &m) {
+            const auto trace = m(0, 0) + m(1, 1) + m(2, 2);
+            if (trace > 0) {
+                const auto s = std::sqrt(trace + T(1)) * T(2);
+                return Quaternion(T(0.25) * s, (m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s,
+                                  (m(1, 0) - m(0, 1)) / s);
+            }
+            if (m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+                const auto s = std::sqrt(T(1) + m(0, 0) - m(1, 1) - m(2, 2)) * T(2);
+                return Quaternion((m(2, 1) - m(1, 2)) / s, T(0.25) * s, (m(0, 1) + m(1, 0)) / s,
+                                  (m(0, 2) + m(2, 0)) / s);
+            }
+            if (m(1, 1) > m(2, 2)) {
+                const auto s = std::sqrt(T(1) + m(1, 1) - m(0, 0) - m(2, 2)) * T(2);
+                return Quaternion((m(0, 2) - m(2, 0)) / s, (m(0, 1) + m(1, 0)) / s, T(0.25) * s,
+                                  (m(1, 2) + m(2, 1)) / s);
+            }
+            const auto s = std::sqrt(T(1) + m(2, 2) - m(0, 0) - m(1, 1)) * T(2);
+            return Quaternion((m(1, 0) - m(0, 1)) / s, (m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s,
+                              T(0.25) * s);
+        }
+
+        /// @brief Pretty print a quaternion.
+        friend std::ostream &operator<<(std::ostream &os, const Quaternion &q) {
+            return os << "Quaternion[" << q._w << ';' << q._v[0] << ';' << q._v[1] << ';' << q._v[2] << ']';
+        }
+    };
+
+    /**
+     * @class DualQuaternion
+     * @brief Rigid transform as a dual quaternion real + eps * dual.
+     *
+     * Dual quaternions blend rigid transforms without the shrinking artifacts of blended
+     * matrices (see Skinning.h). The real part is the rotation, the dual part encodes the
+     * translation: dual = 0.5 * (0, t) * real.
+     *
+     * @tparam T The scalar type. Must be floating point.
+     */
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    class DualQuaternion {
+    private:
+        Quaternion<T> _real;
+        Quaternion<T> _dual;
+
+    public:
+        /// @brief Default constructor gives the identity transform.
+        constexpr DualQuaternion() : _real(), _dual(T(0), T(0), T(0), T(0)) {
+        }
+
+        constexpr DualQuaternion(const Quaternion<T> &real, const Quaternion<T> &dual) : _real(real), _dual(dual) {
+        }
+
+        /// @brief Rotation by `rotation` (unit) followed by translation by `translation`.
+        [[nodiscard]] static DualQuaternion from_rigid(const Quaternion<T> &rotation, const Vector<3, T> &translation) {
+            return DualQuaternion(rotation, Quaternion<T>(T(0), translation) * rotation * T(0.5));
+        }
+
+        [[nodiscard]] constexpr const Quaternion<T> &real() const {
+            return _real;
+        }
+
+        [[nodiscard]] constexpr const Quaternion<T> &dual() const {
+            return _dual;
+        }
+
+        /// @brief Component-wise scaling (used for blending).
+        [[nodiscard]] constexpr DualQuaternion operator*(T scalar) const {
+            return DualQuaternion(_real * scalar, _dual * scalar);
+        }
+
+        /// @brief Component-wise sum (used for blending).
+        [[nodiscard]] constexpr DualQuaternion operator+(const DualQuaternion &other) const {
+            return DualQuaternion(_real + other._real, _dual + other._dual);
+        }
+
+        /// @brief Divide by the magnitude of the real part, giving a unit dual quaternion.
+        [[nodiscard]] DualQuaternion normalized() const {
+            const auto mag = _real.magnitude();
+            assert(mag > 0 && "Cannot normalize a dual quaternion with a zero real part.");
+            return *this * (T(1) / mag);
+        }
+
+        /// @brief Translation encoded by a unit dual quaternion: 2 * dual * conj(real).
+        [[nodiscard]] Vector<3, T> translation() const {
+            return (_dual * _real.conjugate()).vec() * T(2);
+        }
+
+        /// @brief Apply a unit dual quaternion to a point.
+        [[nodiscard]] Vector<3, T> transform_point(const Vector<3, T> &p) const {
+            return _real.rotate(p) + translation();
+        }
+
+        /// @brief Apply the rotation of a unit dual quaternion to a direction.
+        [[nodiscard]] Vector<3, T> transform_vector(const Vector<3, T> &v) const {
+            return _real.rotate(v);
+        }
+    };
+
+    // Typedefs for common use cases.
+    using Quaternionf = Quaternion<float>;
+    using Quaterniond = Quaternion<double>;
+    using DualQuaternionf = DualQuaternion<float>;
+    using DualQuaterniond = DualQuaternion<double>;
+} // namespace Geometry
+
+#endif // QUATERNION_H
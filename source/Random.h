@@ -0,0 +1,371 @@
+/**
+ * @file Random.h
+ * @brief Random and low-discrepancy sampling of spheres, hemispheres, disks and triangles.
+ *
+ * - `Philox4x32` is counter-based: sample i of a batch is a pure function of (seed, i), so
+ *   batched fills give identical results whatever the thread count or chunking, and the
+ *   per-element work has no loop-carried state (it vectorizes across elements).
+ * - `Xoshiro256pp` is a small sequential generator for scalar code, with `jump()` to hand
+ *   out non-overlapping per-thread streams.
+ * - `halton` and `sobol` give stratified 2D points for lower-variance integration.
+ *
+ * `map_*` functions turn a point of [0, 1)^2 into a sample of a domain; the batched
+ * `sample_*` functions combine a point sequence and a mapping to fill `Vector` arrays.
+ * Requires C++20
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <type_traits>
+
+#include "Parallel.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /**
+     * @class Philox4x32
+     * @brief Philox4x32-10 counter-based generator (Salmon et al., "Random123").
+     *
+     * Each call maps a 128-bit counter to 128 random bits under a 64-bit key.
+     */
+    class Philox4x32 {
+    public:
+        using Counter = std::array<std::uint32_t, 4>;
+
+        constexpr explicit Philox4x32(std::uint64_t key)
+            : _key{static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32)} {
+        }
+
+        /// @brief Random bits of `counter`.
+        [[nodiscard]] constexpr Counter operator()(Counter counter) const {
+            auto key = _key;
+            for (int round = 0; round < 10; ++round) {
+                const auto p0 = std::uint64_t{0xD2511F53u} * counter[0];
+                const auto p1 = std::uint64_t{0xCD9E8D57u} * counter[2];
+                counter = {
+                    static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ key[0], static_cast<std::uint32_t>(p1),
+                    static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ key[1], static_cast<std::uint32_t>(p0)
+                };
+                key[0] += 0x9E3779B9u;
+                key[1] += 0xBB67AE85u;
+            }
+            return counter;
+        }
+
+        /// @brief Random bits of element `index` of stream `stream`.
+        [[nodiscard]] constexpr Counter operator()(std::uint64_t index, std::uint64_t stream = 0) const {
+            return (*this)(Counter{static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+                                   static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)});
+        }
+
+    private:
+        std::array<std::uint32_t, 2> _key;
+    };
+
+    /**
+     * @class Xoshiro256pp
+     * @brief xoshiro256++ (Blackman & Vigna), a UniformRandomBitGenerator.
+     */
+    class Xoshiro256pp {
+    public:
+        using result_type = std::uint64_t;
+
+        /// @brief Seed the 256-bit state with splitmix64.
+        constexpr explicit Xoshiro256pp(std::uint64_t seed) {
+            for (auto &word: _state) {
+                seed += 0x9E3779B97F4A7C15ull;
+                auto z = seed;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        static constexpr result_type max() {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        constexpr result_type operator()() {
+            const auto result = std::rotl(_state[0] + _state[3], 23) + _state[0];
+            const auto t = _state[1] << 17;
+            _state[2] ^= _state[0];
+            _state[3] ^= _state[1];
+            _state[1] ^= _state[2];
+            _state[0] ^= _state[3];
+            _state[2] ^= t;
+            _state[3] = std::rotl(_state[3], 45);
+            return result;
+        }
+
+        /// @brief Advance by 2^128 draws; call k times to get the k-th independent stream.
+        constexpr void jump() {
+            constexpr std::array<std::uint64_t, 4> polynomial{
+                0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull
+            };
+            std::array<std::uint64_t, 4> jumped{};
+            for (const auto word: polynomial) {
+                for (int bit = 0; bit < 64; ++bit) {
+                    if (word & (std::uint64_t{1} << bit)) {
+                        for (std::size_t i = 0; i < 4; ++i) {
+                            jumped[i] ^= _state[i];
+                        }
+                    }
+                    (*this)();
+                }
+            }
+            _state = jumped;
+        }
+
+    private:
+        std::array<std::uint64_t, 4> _state{};
+    };
+
+    /// @brief Uniform value in [0, 1) from 32 random bits (24 significant bits for float).
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] constexpr T to_unit(std::uint32_t bits) {
+        if constexpr (std::is_same_v<T, float>) {
+            return static_cast<float>(bits >> 8) * 0x1.0p-24f;
+        } else {
+            return static_cast<T>(bits) * T(0x1.0p-32);
+        }
+    }
+
+    /// @brief Uniform value in [0, 1) from 64 random bits (53 significant bits for double).
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] constexpr T to_unit(std::uint64_t bits) {
+        if constexpr (std::is_same_v<T, float>) {
+            return to_unit<float>(static_cast<std::uint32_t>(bits >> 32));
+        } else {
+            return static_cast<T>(bits >> 11) * T(0x1.0p-53);
+        }
+    }
+
+    /// @brief Radical inverse of `index` in base `base` (one Halton coordinate).
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] constexpr T halton(std::uint64_t index, std::uint32_t base) {
+        const auto inv_base = T(1) / static_cast<T>(base);
+        T result = 0, scale = inv_base;
+        while (index > 0) {
+            result += static_cast<T>(index % base) * scale;
+            index /= base;
+            scale *= inv_base;
+        }
+        return std::min(result, T(1) - std::numeric_limits<T>::epsilon() / 2);
+    }
+
+    /**
+     * @brief Point `index` of the 2D Sobol sequence, optionally digit-scrambled.
+     * @param scramble Random bits XOR-ed into each coordinate (0 for the plain sequence).
+     */
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] constexpr Vector<2, T> sobol(std::uint32_t index, std::uint64_t scramble = 0) {
+        // First dimension: van der Corput; second: direction numbers of x + 1.
+        auto x = static_cast<std::uint32_t>(scramble), y = static_cast<std::uint32_t>(scramble >> 32);
+        std::uint32_t v = 1u << 31;
+        for (auto i = index, bit = 0u; i != 0; i >>= 1, ++bit, v ^= v >> 1) {
+            if (i & 1u) {
+                x ^= 1u << (31 - bit);
+                y ^= v;
+            }
+        }
+        return Vector<2, T>(to_unit<T>(x), to_unit<T>(y));
+    }
+
+    /// @brief Uniform point on the unit sphere.
+    template<typename T>
+    [[nodiscard]] Vector<3, T> map_sphere(const Vector<2, T> &u) {
+        const auto z = T(1) - T(2) * u[0];
+        const auto r = std::sqrt(std::max(T(0), T(1) - z * z));
+        const auto phi = T(2) * std::numbers::pi_v<T> * u[1];
+        return Vector<3, T>(r * std::cos(phi), r * std::sin(phi), z);
+    }
+
+    /// @brief Uniform point on the unit hemisphere around +z.
+    template<typename T>
+    [[nodiscard]] Vector<3, T> map_hemisphere(const Vector<2, T> &u) {
+        const auto z = T(1) - u[0];
+        const auto r = std::sqrt(std::max(T(0), T(1) - z * z));
+        const auto phi = T(2) * std::numbers::pi_v<T> * u[1];
+        return Vector<3, T>(r * std::cos(phi), r * std::sin(phi), z);
+    }
+
+    /// @brief Uniform point in the unit disk (polar mapping, branch-free).
+    template<typename T>
+    [[nodiscard]] Vector<2, T> map_disk(const Vector<2, T> &u) {
+        const auto r = std::sqrt(u[0]);
+        const auto phi = T(2) * std::numbers::pi_v<T> * u[1];
+        return Vector<2, T>(r * std::cos(phi), r * std::sin(phi));
+    }
+
+    /// @brief Cosine-weighted direction on the hemisphere around +z (disk lifted to the hemisphere).
+    template<typename T>
+    [[nodiscard]] Vector<3, T> map_cosine_hemisphere(const Vector<2, T> &u) {
+        const auto d = map_disk(u);
+        return Vector<3, T>(d[0], d[1], std::sqrt(std::max(T(0), T(1) - d[0] * d[0] - d[1] * d[1])));
+    }
+
+    /// @brief Uniform point in the triangle (a, b, c).
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] Vector<Dim, T> map_triangle(const Vector<2, T> &u, const Vector<Dim, T> &a,
+                                              const Vector<Dim, T> &b, const Vector<Dim, T> &c) {
+        const auto su = std::sqrt(u[0]);
+        return a * (T(1) - su) + b * (su * (T(1) - u[1])) + c * (su * u[1]);
+    }
+
+    /// @brief Source of the [0, 1)^2 points fed to the mappings.
+    enum class SampleSequence {
+        Random, ///< Philox, independent uniform points.
+        Halton, ///< Halton bases (2, 3), shifted by the seed (Cranley-Patterson rotation).
+        Sobol ///< 2D Sobol, digit-scrambled by the seed.
+    };
+
+    namespace detail {
+        /// Seed-derived Halton shift / Sobol scramble bits: one Philox call per seed.
+        [[nodiscard]] constexpr Philox4x32::Counter sequence_scramble(std::uint64_t seed) {
+            return Philox4x32(seed)(0, ~std::uint64_t{0});
+        }
+
+        template<typename T>
+        [[nodiscard]] Vector<2, T> halton_point(std::uint64_t index, const Philox4x32::Counter &shift) {
+            auto x = halton<T>(index, 2) + to_unit<T>(shift[0]);
+            auto y = halton<T>(index, 3) + to_unit<T>(shift[1]);
+            x -= std::floor(x);
+            y -= std::floor(y);
+            return Vector<2, T>(x, y);
+        }
+
+        template<typename T>
+        [[nodiscard]] constexpr Vector<2, T> sobol_point(std::uint64_t index, const Philox4x32::Counter &scramble) {
+            return sobol<T>(static_cast<std::uint32_t>(index), (std::uint64_t{scramble[1]} << 32) | scramble[0]);
+        }
+
+        template<typename T>
+        [[nodiscard]] constexpr Vector<2, T> random_point(const Philox4x32 &philox, std::uint64_t index) {
+            const auto bits = philox(index);
+            if constexpr (std::is_same_v<T, float>) {
+                return Vector<2, T>(to_unit<T>(bits[0]), to_unit<T>(bits[1]));
+            } else {
+                return Vector<2, T>(to_unit<T>((std::uint64_t{bits[0]} << 32) | bits[1]),
+                                    to_unit<T>((std::uint64_t{bits[2]} << 32) | bits[3]));
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @brief Point `index` of `sequence` under `seed`.
+     * @note Pure function of its arguments: this is what makes batched fills reproducible.
+     */
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] Vector<2, T> unit_square_point(SampleSequence sequence, std::uint64_t seed, std::uint64_t index) {
+        switch (sequence) {
+            case SampleSequence::Halton:
+                return detail::halton_point<T>(index, detail::sequence_scramble(seed));
+            case SampleSequence::Sobol:
+                assert(index <= std::numeric_limits<std::uint32_t>::max() && "Sobol index out of range.");
+                return detail::sobol_point<T>(index, detail::sequence_scramble(seed));
+            case SampleSequence::Random:
+            default:
+                return detail::random_point<T>(Philox4x32(seed), index);
+        }
+    }
+
+    /**
+     * @brief Fill `out[i] = map(unit_square_point(sequence, seed, first_index + i))`.
+     *
+     * The result is independent of `threads`; consecutive calls continue a sequence by
+     * advancing `first_index`. The seed scramble and the choice of sequence are made once
+     * per call, not per element.
+     */
+    template<unsigned int Dim, typename T, typename Map>
+    void sample_mapped(std::span<Vector<Dim, T>> out, Map &&map, std::uint64_t seed,
+                       SampleSequence sequence = SampleSequence::Random, std::uint64_t first_index = 0,
+                       unsigned int threads = 1) {
+        const auto fill = [&](auto point) {
+            parallel_for(out.size(), [&](std::size_t begin, std::size_t end, unsigned int) {
+                for (auto i = begin; i < end; ++i) {
+                    out[i] = map(point(first_index + i));
+                }
+            }, threads);
+        };
+        switch (sequence) {
+            case SampleSequence::Halton: {
+                const auto shift = detail::sequence_scramble(seed);
+                fill([&shift](std::uint64_t index) { return detail::halton_point<T>(index, shift); });
+                break;
+            }
+            case SampleSequence::Sobol: {
+                assert((out.empty() || first_index + (out.size() - 1) <= std::numeric_limits<std::uint32_t>::max())
+                    && "Sobol index out of range.");
+                const auto scramble = detail::sequence_scramble(seed);
+                fill([&scramble](std::uint64_t index) { return detail::sobol_point<T>(index, scramble); });
+                break;
+            }
+            case SampleSequence::Random:
+            default: {
+                const Philox4x32 philox(seed);
+                fill([&philox](std::uint64_t index) { return detail::random_point<T>(philox, index); });
+                break;
+            }
+        }
+    }
+
+    /// @brief Uniform points on the unit sphere; see `sample_mapped`.
+    template<typename T>
+    void sample_sphere(std::span<Vector<3, T>> out, std::uint64_t seed,
+                       SampleSequence sequence = SampleSequence::Random, std::uint64_t first_index = 0,
+                       unsigned int threads = 1) {
+        sample_mapped(out, map_sphere<T>, seed, sequence, first_index, threads);
+    }
+
+    /// @brief Uniform (or cosine-weighted) points on the unit hemisphere around +z; see `sample_mapped`.
+    template<typename T>
+    void sample_hemisphere(std::span<Vector<3, T>> out, std::uint64_t seed, bool cosine_weighted = false,
+                           SampleSequence sequence = SampleSequence::Random, std::uint64_t first_index = 0,
+                           unsigned int threads = 1) {
+        if (cosine_weighted) {
+            sample_mapped(out, map_cosine_hemisphere<T>, seed, sequence, first_index, threads);
+        } else {
+            sample_mapped(out, map_hemisphere<T>, seed, sequence, first_index, threads);
+        }
+    }
+
+    /// @brief Uniform points in the unit disk; see `sample_mapped`.
+    template<typename T>
+    void sample_disk(std::span<Vector<2, T>> out, std::uint64_t seed,
+                     SampleSequence sequence = SampleSequence::Random, std::uint64_t first_index = 0,
+                     unsigned int threads = 1) {
+        sample_mapped(out, map_disk<T>, seed, sequence, first_index, threads);
+    }
+
+    /// @brief Uniform points in the triangle (a, b, c); see `sample_mapped`.
+    template<unsigned int Dim, typename T>
+    void sample_triangle(std::span<Vector<Dim, T>> out, const Vector<Dim, T> &a, const Vector<Dim, T> &b,
+                         const Vector<Dim, T> &c, std::uint64_t seed,
+                         SampleSequence sequence = SampleSequence::Random, std::uint64_t first_index = 0,
+                         unsigned int threads = 1) {
+        sample_mapped(out, [&](const Vector<2, T> &u) { return map_triangle(u, a, b, c); },
+                      seed, sequence, first_index, threads);
+    }
+} // namespace Geometry
+
+#endif // RANDOM_H
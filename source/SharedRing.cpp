@@ -0,0 +1,122 @@
+#include "SharedRing.h"
+
+#include <cerrno>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GEOMETRY_HAS_POSIX_SHM 1
+#endif
+
+namespace Geometry
+{
+    namespace detail
+    {
+#if defined(GEOMETRY_HAS_POSIX_SHM)
+        namespace
+        {
+            std::byte *map_fd(int fd, std::size_t bytes, const std::string &name) {
+                void *data = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                const auto error = errno;
+                close(fd);
+                if (data == MAP_FAILED) {
+                    throw std::system_error(error, std::generic_category(), "mmap '" + name + "'");
+                }
+                return static_cast<std::byte *>(data);
+            }
+        } // namespace
+
+        SharedMemory SharedMemory::create(const std::string &name, std::size_t bytes) {
+            // Drop a stale object left by a crashed producer.
+            shm_unlink(name.c_str());
+            const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "shm_open '" + name + "'");
+            }
+            if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+                const auto error = errno;
+                close(fd);
+                shm_unlink(name.c_str());
+                throw std::system_error(error, std::generic_category(), "ftruncate '" + name + "'");
+            }
+
+            SharedMemory memory;
+            memory._name = name;
+            memory._owner = true;
+            memory._size = bytes;
+            try {
+                memory._data = map_fd(fd, bytes, name);
+            } catch (...) {
+                shm_unlink(name.c_str());
+                throw;
+            }
+            return memory;
+        }
+
+        SharedMemory SharedMemory::open(const std::string &name) {
+            const int fd = shm_open(name.c_str(), O_RDWR, 0);
+            if (fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "shm_open '" + name + "'");
+            }
+            struct stat info{};
+            if (fstat(fd, &info) != 0) {
+                const auto error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(), "fstat '" + name + "'");
+            }
+
+            SharedMemory memory;
+            memory._name = name;
+            memory._size = static_cast<std::size_t>(info.st_size);
+            memory._data = map_fd(fd, memory._size, name);
+            return memory;
+        }
+
+        void SharedMemory::release() noexcept {
+            if (_data != nullptr) {
+                munmap(_data, _size);
+            }
+            if (_owner) {
+                shm_unlink(_name.c_str());
+            }
+            _data = nullptr;
+            _size = 0;
+            _owner = false;
+        }
+#else
+        SharedMemory SharedMemory::create(const std::string &, std::size_t) {
+            throw std::runtime_error("Shared vector rings require POSIX shared memory.");
+        }
+
+        SharedMemory SharedMemory::open(const std::string &) {
+            throw std::runtime_error("Shared vector rings require POSIX shared memory.");
+        }
+
+        void SharedMemory::release() noexcept {
+        }
+#endif
+
+        SharedMemory::SharedMemory(SharedMemory &&other) noexcept
+            : _name(std::move(other._name)), _data(std::exchange(other._data, nullptr)),
+              _size(std::exchange(other._size, 0)), _owner(std::exchange(other._owner, false)) {
+        }
+
+        SharedMemory &SharedMemory::operator=(SharedMemory &&other) noexcept {
+            if (this != &other) {
+                release();
+                _name = std::move(other._name);
+                _data = std::exchange(other._data, nullptr);
+                _size = std::exchange(other._size, 0);
+                _owner = std::exchange(other._owner, false);
+            }
+            return *this;
+        }
+
+        SharedMemory::~SharedMemory() {
+            release();
+        }
+    } // namespace detail
+} // namespace Geometry
@@ -0,0 +1,344 @@
+/**
+ * @file SharedRing.h
+ * @brief Zero-copy publication of vector arrays between processes through shared memory.
+ *
+ * A producer creates a named POSIX shared-memory object (`shm_open` + `mmap`) holding a
+ * versioned header and a ring of slots. Each slot stores one frame of up to `capacity`
+ * vectors, either as an array of `Vector<Dim, T>` (AoS, the in-memory layout of the library
+ * type) or as `Dim` component arrays (SoA). Consumers map the same object and read the
+ * latest frame in place through `std::span` / `SoASpan`, without copying.
+ *
+ * Synchronization is a per-slot sequence lock, single producer / many consumers, lock-free:
+ *  - the producer marks the slot odd (being written), fills it, marks it even (published),
+ *    then advances the `latest` frame counter;
+ *  - a consumer picks the slot of `latest`, checks it is published for that frame, reads the
+ *    data in place and finally calls `still_valid()`. If the producer lapped the ring in the
+ *    meantime (after `slots - 1` newer frames) the check fails and the read must be discarded.
+ * Use at least 3 slots so the producer never writes the slot consumers are most likely reading.
+ *
+ * Example:
+ * @code
+ * // Simulator
+ * auto ring = SharedVectorRing<3, float>::create("/particles", VectorLayout::AoS, 100'000);
+ * auto out = ring.write_aos();
+ * // ... fill out[0 .. n) ...
+ * ring.publish(n);
+ *
+ * // Renderer
+ * auto ring = SharedVectorRing<3, float>::open("/particles");
+ * if (auto frame = ring.acquire_latest()) {
+ *     draw(ring.aos(*frame));
+ *     if (!ring.still_valid(*frame)) { ... discard ... }
+ * }
+ * @endcode
+ * Requires C++20, POSIX shared memory.
+ */
+
+#ifndef SHAREDRING_H
+#define SHAREDRING_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "SoA.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /// @brief Memory layout of the vectors stored in a shared ring slot.
+    enum class VectorLayout : std::uint32_t {
+        AoS = 0,
+        SoA = 1
+    };
+
+    namespace detail {
+        /**
+         * @brief Owned mapping of a named POSIX shared-memory object.
+         *
+         * The creating side unlinks the name on destruction; existing mappings stay valid.
+         */
+        class SharedMemory {
+        public:
+            SharedMemory() = default;
+
+            /// @brief Create (or replace) `name` with `bytes` of zeroed memory and map it.
+            static SharedMemory create(const std::string &name, std::size_t bytes);
+
+            /// @brief Map an existing object read-write.
+            static SharedMemory open(const std::string &name);
+
+            SharedMemory(const SharedMemory &) = delete;
+            SharedMemory &operator=(const SharedMemory &) = delete;
+
+            SharedMemory(SharedMemory &&other) noexcept;
+            SharedMemory &operator=(SharedMemory &&other) noexcept;
+            ~SharedMemory();
+
+            [[nodiscard]] std::byte *data() const {
+                return _data;
+            }
+
+            [[nodiscard]] std::size_t size() const {
+                return _size;
+            }
+
+        private:
+            void release() noexcept;
+
+            std::string _name;
+            std::byte *_data = nullptr;
+            std::size_t _size = 0;
+            bool _owner = false;
+        };
+
+        /// @brief Start of the shared object. Fields written once by the producer before `magic`.
+        struct SharedRingHeader {
+            std::uint32_t magic;
+            std::uint32_t version;
+            std::uint32_t layout;
+            std::uint32_t dim;
+            std::uint32_t scalar_size;
+            std::uint32_t scalar_kind;
+            std::uint32_t slot_count;
+            std::uint32_t reserved;
+            std::uint64_t capacity;
+            std::uint64_t slot_stride;
+            std::uint64_t latest;
+        };
+
+        /// @brief Per-slot sequence lock and frame description, followed by the slot data.
+        struct SharedSlotHeader {
+            std::uint64_t sequence;
+            std::uint64_t count;
+        };
+
+        inline constexpr std::uint32_t shared_ring_magic = 0x47565247; // "GVRG"
+        inline constexpr std::uint32_t shared_ring_version = 1;
+        inline constexpr std::size_t shared_ring_alignment = 64;
+
+        constexpr std::size_t align_up(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        template<typename T>
+        constexpr std::uint32_t scalar_kind() {
+            return std::is_floating_point_v<T> ? 2 : (std::is_signed_v<T> ? 1 : 0);
+        }
+    } // namespace detail
+
+    /**
+     * @class SharedVectorRing
+     * @brief Single-producer / multi-consumer ring of vector frames in shared memory.
+     *
+     * @tparam Dim The dimension of the published vectors.
+     * @tparam T The scalar type; must match between producer and consumers.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_arithmetic_v<T>
+    class SharedVectorRing {
+    public:
+        /// @brief A frame selected by `acquire_latest`; valid for reading until `still_valid` fails.
+        struct Frame {
+            std::uint64_t number;
+            std::uint64_t sequence;
+            std::size_t count;
+            const std::byte *data;
+        };
+
+        /**
+         * @brief Create the shared object `name` (e.g. "/particles") as the producer.
+         * @param capacity Maximum number of vectors per frame.
+         * @param slots Number of frames in the ring (at least 2, 3 or more recommended).
+         */
+        static SharedVectorRing create(const std::string &name, VectorLayout layout, std::size_t capacity,
+                                       std::uint32_t slots = 3) {
+            if (slots < 2) {
+                throw std::invalid_argument("A shared ring needs at least two slots.");
+            }
+            const auto stride = slot_stride(capacity);
+            const auto header_size = detail::align_up(sizeof(detail::SharedRingHeader), detail::shared_ring_alignment);
+            SharedVectorRing ring(detail::SharedMemory::create(name, header_size + stride * slots));
+
+            auto &header = ring.header();
+            header.version = detail::shared_ring_version;
+            header.layout = static_cast<std::uint32_t>(layout);
+            header.dim = Dim;
+            header.scalar_size = sizeof(T);
+            header.scalar_kind = detail::scalar_kind<T>();
+            header.slot_count = slots;
+            header.capacity = capacity;
+            header.slot_stride = stride;
+            // Publishing the magic number makes the header visible to consumers.
+            std::atomic_ref(header.magic).store(detail::shared_ring_magic, std::memory_order_release);
+            return ring;
+        }
+
+        /**
+         * @brief Map an existing ring as a consumer.
+         * @throws std::runtime_error if the object is not a compatible ring (or not initialized yet).
+         */
+        static SharedVectorRing open(const std::string &name) {
+            SharedVectorRing ring(detail::SharedMemory::open(name));
+            if (ring._memory.size() < sizeof(detail::SharedRingHeader)) {
+                throw std::runtime_error("Shared ring '" + name + "' is too small.");
+            }
+            auto &header = ring.header();
+            if (std::atomic_ref(header.magic).load(std::memory_order_acquire) != detail::shared_ring_magic) {
+                throw std::runtime_error("Shared ring '" + name + "' is not initialized.");
+            }
+            if (header.version != detail::shared_ring_version) {
+                throw std::runtime_error("Shared ring '" + name + "' has an unsupported version.");
+            }
+            if (header.dim != Dim || header.scalar_size != sizeof(T) || header.scalar_kind != detail::scalar_kind<T>()) {
+                throw std::runtime_error("Shared ring '" + name + "' holds another vector type.");
+            }
+            if (header.layout != static_cast<std::uint32_t>(VectorLayout::AoS)
+                && header.layout != static_cast<std::uint32_t>(VectorLayout::SoA)) {
+                throw std::runtime_error("Shared ring '" + name + "' has an unknown layout.");
+            }
+            // The header is untrusted: bound every field by the mapped size before multiplying.
+            const auto header_size = detail::align_up(sizeof(detail::SharedRingHeader), detail::shared_ring_alignment);
+            const auto available = ring._memory.size() - std::min(ring._memory.size(), header_size);
+            if (header.slot_count < 2 || header.capacity > available / (Dim * sizeof(T))
+                || header.slot_stride != slot_stride(header.capacity)
+                || header.slot_count > available / header.slot_stride) {
+                throw std::runtime_error("Shared ring '" + name + "' is corrupted.");
+            }
+            return ring;
+        }
+
+        [[nodiscard]] VectorLayout layout() const {
+            return static_cast<VectorLayout>(header().layout);
+        }
+
+        [[nodiscard]] std::size_t capacity() const {
+            return header().capacity;
+        }
+
+        // Producer side.
+
+        /// @brief Writable AoS view of the next slot; marks it as being written.
+        [[nodiscard]] std::span<Vector<Dim, T>> write_aos() {
+            assert(layout() == VectorLayout::AoS && "Ring does not use the AoS layout.");
+            return {reinterpret_cast<Vector<Dim, T> *>(begin_write()), capacity()};
+        }
+
+        /// @brief Writable SoA view of the next slot; marks it as being written.
+        [[nodiscard]] SoASpan<Dim, T> write_soa() {
+            assert(layout() == VectorLayout::SoA && "Ring does not use the SoA layout.");
+            auto *data = reinterpret_cast<T *>(begin_write());
+            std::array<std::span<T>, Dim> components;
+            for (auto c = 0u; c < Dim; ++c) {
+                components[c] = std::span<T>(data + c * capacity(), capacity());
+            }
+            return SoASpan<Dim, T>(components);
+        }
+
+        /// @brief Publish the slot obtained by the last `write_*()` call with `count` vectors.
+        void publish(std::size_t count) {
+            assert(_writing && "publish() requires a preceding write_aos() / write_soa().");
+            assert(count <= capacity() && "Frame exceeds the ring capacity.");
+            auto &h = header();
+            const auto frame = std::atomic_ref(h.latest).load(std::memory_order_relaxed) + 1;
+            auto &slot = slot_header(frame);
+            slot.count = count;
+            std::atomic_ref(slot.sequence).store(2 * frame + 2, std::memory_order_release);
+            std::atomic_ref(h.latest).store(frame, std::memory_order_release);
+            _writing = false;
+        }
+
+        // Consumer side.
+
+        /// @brief Select the most recent published frame, if any.
+        [[nodiscard]] std::optional<Frame> acquire_latest() const {
+            const auto frame = std::atomic_ref(header().latest).load(std::memory_order_acquire);
+            if (frame == 0) {
+                return std::nullopt;
+            }
+            auto &slot = slot_header(frame);
+            const auto sequence = std::atomic_ref(slot.sequence).load(std::memory_order_acquire);
+            if (sequence != 2 * frame + 2 || slot.count > capacity()) {
+                // Already being overwritten by a newer frame, or not a frame this ring can hold.
+                return std::nullopt;
+            }
+            return Frame{frame, sequence, slot.count, slot_data(frame)};
+        }
+
+        /// @brief In-place AoS view of a frame.
+        [[nodiscard]] std::span<const Vector<Dim, T>> aos(const Frame &frame) const {
+            assert(layout() == VectorLayout::AoS && "Ring does not use the AoS layout.");
+            return {reinterpret_cast<const Vector<Dim, T> *>(frame.data), frame.count};
+        }
+
+        /// @brief In-place SoA view of a frame.
+        [[nodiscard]] SoASpan<Dim, const T> soa(const Frame &frame) const {
+            assert(layout() == VectorLayout::SoA && "Ring does not use the SoA layout.");
+            const auto *data = reinterpret_cast<const T *>(frame.data);
+            std::array<std::span<const T>, Dim> components;
+            for (auto c = 0u; c < Dim; ++c) {
+                components[c] = std::span<const T>(data + c * capacity(), frame.count);
+            }
+            return SoASpan<Dim, const T>(components);
+        }
+
+        /// @brief True if the producer has not started overwriting `frame` since it was acquired.
+        [[nodiscard]] bool still_valid(const Frame &frame) const {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return std::atomic_ref(slot_header(frame.number).sequence).load(std::memory_order_relaxed)
+                   == frame.sequence;
+        }
+
+    private:
+        static_assert(sizeof(Vector<Dim, T>) == Dim * sizeof(T), "Vector must be tightly packed to be shared.");
+
+        explicit SharedVectorRing(detail::SharedMemory memory) : _memory(std::move(memory)) {
+        }
+
+        static std::size_t slot_stride(std::size_t capacity) {
+            return detail::align_up(sizeof(detail::SharedSlotHeader), detail::shared_ring_alignment)
+                   + detail::align_up(capacity * Dim * sizeof(T), detail::shared_ring_alignment);
+        }
+
+        [[nodiscard]] detail::SharedRingHeader &header() const {
+            return *reinterpret_cast<detail::SharedRingHeader *>(_memory.data());
+        }
+
+        [[nodiscard]] std::byte *slot_begin(std::uint64_t frame) const {
+            const auto &h = header();
+            const auto header_size = detail::align_up(sizeof(detail::SharedRingHeader), detail::shared_ring_alignment);
+            return _memory.data() + header_size + (frame % h.slot_count) * h.slot_stride;
+        }
+
+        [[nodiscard]] detail::SharedSlotHeader &slot_header(std::uint64_t frame) const {
+            return *reinterpret_cast<detail::SharedSlotHeader *>(slot_begin(frame));
+        }
+
+        [[nodiscard]] std::byte *slot_data(std::uint64_t frame) const {
+            return slot_begin(frame) + detail::align_up(sizeof(detail::SharedSlotHeader), detail::shared_ring_alignment);
+        }
+
+        std::byte *begin_write() {
+            const auto frame = std::atomic_ref(header().latest).load(std::memory_order_relaxed) + 1;
+            auto &slot = slot_header(frame);
+            std::atomic_ref(slot.sequence).store(2 * frame + 1, std::memory_order_relaxed);
+            // Order the odd sequence before any data store.
+            std::atomic_thread_fence(std::memory_order_release);
+            _writing = true;
+            return slot_data(frame);
+        }
+
+        detail::SharedMemory _memory;
+        bool _writing = false;
+    };
+} // namespace Geometry
+
+#endif // SHAREDRING_H
@@ -0,0 +1,219 @@
+/**
+ * @file Skinning.h
+ * @brief Batched skeletal skinning: linear blend (LBS) and dual quaternion (DQS).
+ *
+ * Vertices are stored as SoA (`SoASpan<3, T>`), and so are the up to 4 influences per
+ * vertex: `SkinWeights::bones[k][v]` / `SkinWeights::weights[k][v]` are the k-th bone
+ * index and weight of vertex v. Unused influences have weight 0; weights are expected to
+ * sum to 1.
+ *
+ * - LBS blends the 4 bone matrices (12 scalars each) per vertex, then applies the blended
+ *   3x4 matrix to the position and normal: one matrix application instead of four.
+ * - DQS blends unit dual quaternions (sign-aligned on the first influence), normalizes,
+ *   and applies the rigid result, which avoids the volume loss of LBS on twisting joints.
+ *
+ * Both kernels split vertices across `threads` workers with `parallel_for`; `bench skinning`
+ * reports their throughput in vertices per second.
+ * Requires C++20
+ */
+
+#ifndef SKINNING_H
+#define SKINNING_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Parallel.h"
+#include "Quaternion.h"
+#include "SoA.h"
+#include "Transform3.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /// @brief Maximum number of bone influences per vertex.
+    inline constexpr std::size_t max_skin_influences = 4;
+
+    /// @brief SoA bone indices and weights of a skinned mesh.
+    template<typename T>
+    struct SkinWeights {
+        std::array<std::span<const std::uint16_t>, max_skin_influences> bones;
+        std::array<std::span<const T>, max_skin_influences> weights;
+    };
+
+    namespace detail {
+        /// Debug-build checks of the influence spans, bone indices included; empty with NDEBUG.
+        template<typename T>
+        void check_skin_inputs(const SkinWeights<T> &influences, std::size_t vertex_count, std::size_t bone_count) {
+#ifndef NDEBUG
+            for (std::size_t k = 0; k < max_skin_influences; ++k) {
+                assert(influences.bones[k].size() >= vertex_count && "Missing bone indices.");
+                assert(influences.weights[k].size() >= vertex_count && "Missing bone weights.");
+                for (std::size_t v = 0; v < vertex_count; ++v) {
+                    assert(influences.bones[k][v] < bone_count && "Bone index out of range.");
+                }
+            }
+#endif
+            (void) influences;
+            (void) vertex_count;
+            (void) bone_count;
+        }
+
+        /// Vertices per block of the linear blend kernel (3 KB of blended float matrices).
+        inline constexpr std::size_t skin_block_size = 64;
+
+        /**
+         * Linear blend skinning of vertices [begin, end), a block at a time: the 12 elements of
+         * every blended matrix go to a local array, where the fold over them vectorizes (3 or
+         * 1.5 vectors per bone instead of 12 scalar multiply-adds), then the block is transformed.
+         * Local arrays cannot alias the inputs, and flattening inlines the folds.
+         *
+         * `matrices` holds the 12 elements of bone b at 12 * b (see `skin_linear`).
+         */
+        template<typename T>
+        [[gnu::flatten]] void skin_linear_lanes(std::span<const T> matrices, const SkinWeights<T> &influences,
+                                                SoASpan<3, const T> positions, SoASpan<3, T> out_positions,
+                                                SoASpan<3, const T> normals, SoASpan<3, T> out_normals,
+                                                std::size_t begin, std::size_t end) {
+            constexpr std::size_t block = skin_block_size;
+            std::array<std::array<T, 12>, block> m;
+            std::array<std::array<T, block>, 3> result;
+            for (auto first = begin; first < end; first += block) {
+                const auto size = std::min(block, end - first);
+                for (auto &matrix: m) {
+                    matrix.fill(T(0));
+                }
+                for (std::size_t k = 0; k < max_skin_influences; ++k) {
+                    const auto index = influences.bones[k].subspan(first, size);
+                    const auto weight = influences.weights[k].subspan(first, size);
+                    for (std::size_t j = 0; j < size; ++j) {
+                        const auto offset = 12 * static_cast<std::uint32_t>(index[j]);
+                        const auto w = weight[j];
+                        [&]<std::size_t... E>(std::index_sequence<E...>) {
+                            ((m[j][E] += w * matrices[offset + E]), ...);
+                        }(std::make_index_sequence<12>{});
+                    }
+                }
+
+                // Points get the translation column, directions do not.
+                const auto apply = [&](auto point, SoASpan<3, const T> in, SoASpan<3, T> out) {
+                    const auto x = in.component(0), y = in.component(1), z = in.component(2);
+                    for (std::size_t j = 0; j < size; ++j) {
+                        const auto px = x[first + j], py = y[first + j], pz = z[first + j];
+                        [&]<std::size_t... R>(std::index_sequence<R...>) {
+                            ((result[R][j] = m[j][4 * R] * px + m[j][4 * R + 1] * py + m[j][4 * R + 2] * pz
+                                             + (decltype(point)::value ? m[j][4 * R + 3] : T(0))), ...);
+                        }(std::make_index_sequence<3>{});
+                    }
+                    for (auto c = 0u; c < 3; ++c) {
+                        std::copy_n(result[c].begin(), size, out.component(c).begin() + first);
+                    }
+                };
+                apply(std::true_type{}, positions, out_positions);
+                if (normals.size() > 0) {
+                    apply(std::false_type{}, normals, out_normals);
+                }
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @brief Linear blend skinning of positions and (optionally) normals.
+     *
+     * @param bones Skinning matrices (bind-pose inverse already applied), one per bone.
+     * @param influences Per-vertex bone indices and weights.
+     * @param positions Rest-pose positions.
+     * @param out_positions Skinned positions (may not alias `positions`).
+     * @param normals Rest-pose normals, or an empty span to skip normals.
+     * @param out_normals Skinned normals, not renormalized (ignored if `normals` is empty).
+     * @param threads Number of worker threads.
+     */
+    template<typename T>
+    void skin_linear(std::span<const Transform3<T>> bones,
+                     const SkinWeights<T> &influences,
+                     SoASpan<3, const T> positions,
+                     SoASpan<3, T> out_positions,
+                     SoASpan<3, const T> normals = {},
+                     SoASpan<3, T> out_normals = {},
+                     unsigned int threads = 1) {
+        const auto count = positions.size();
+        assert(out_positions.size() >= count && "Output positions are too small.");
+        assert((normals.size() == 0 || (normals.size() >= count && out_normals.size() >= count))
+               && "Normal spans are too small.");
+        detail::check_skin_inputs(influences, count, bones.size());
+
+        // One flat array of bone matrices, so the blend reads bone b as the 12 elements at 12 * b.
+        std::vector<T> matrices(12 * bones.size());
+        for (std::size_t b = 0; b < bones.size(); ++b) {
+            std::copy_n(bones[b].matrix().data().begin(), 12, matrices.begin() + 12 * b);
+        }
+        parallel_for(count, [&](std::size_t begin, std::size_t end, unsigned int) {
+            detail::skin_linear_lanes(std::span<const T>(matrices), influences, positions, out_positions, normals, out_normals, begin, end);
+        }, threads);
+    }
+
+    /**
+     * @brief Convert rigid bone transforms to unit dual quaternions for `skin_dual_quaternion`.
+     * @warning Bones must be rigid (rotation + translation, no scale or shear).
+     */
+    template<typename T>
+    void to_dual_quaternions(std::span<const Transform3<T>> bones, std::span<DualQuaternion<T>> out) {
+        assert(out.size() >= bones.size() && "Output span is too small.");
+        for (std::size_t b = 0; b < bones.size(); ++b) {
+            out[b] = DualQuaternion<T>::from_rigid(bones[b].rotation().normalized(), bones[b].translation());
+        }
+    }
+
+    /**
+     * @brief Dual quaternion skinning of positions and (optionally) normals.
+     *
+     * @param bones Unit dual quaternions of the skinning transforms, one per bone.
+     * @param influences Per-vertex bone indices and weights.
+     * @param positions Rest-pose positions.
+     * @param out_positions Skinned positions (may not alias `positions`).
+     * @param normals Rest-pose normals, or an empty span to skip normals.
+     * @param out_normals Skinned normals (unit if the inputs are unit).
+     * @param threads Number of worker threads.
+     */
+    template<typename T>
+    void skin_dual_quaternion(std::span<const DualQuaternion<T>> bones,
+                              const SkinWeights<T> &influences,
+                              SoASpan<3, const T> positions,
+                              SoASpan<3, T> out_positions,
+                              SoASpan<3, const T> normals = {},
+                              SoASpan<3, T> out_normals = {},
+                              unsigned int threads = 1) {
+        const auto count = positions.size();
+        const bool with_normals = normals.size() > 0;
+        assert(out_positions.size() >= count && "Output positions are too small.");
+        assert((!with_normals || (normals.size() >= count && out_normals.size() >= count)) && "Normal spans are too small.");
+        detail::check_skin_inputs(influences, count, bones.size());
+
+        parallel_for(count, [&](std::size_t begin, std::size_t end, unsigned int) {
+            for (auto v = begin; v < end; ++v) {
+                const auto &first = bones[influences.bones[0][v]];
+                auto blended = first * influences.weights[0][v];
+                for (std::size_t k = 1; k < max_skin_influences; ++k) {
+                    const auto &dq = bones[influences.bones[k][v]];
+                    // q and -q are the same rotation: take the one closest to the first bone.
+                    const auto sign = dq.real().dot(first.real()) < 0 ? T(-1) : T(1);
+                    blended = blended + dq * (sign * influences.weights[k][v]);
+                }
+                blended = blended.normalized();
+
+                out_positions.store(v, blended.transform_point(positions.load(v)));
+                if (with_normals) {
+                    out_normals.store(v, blended.transform_vector(normals.load(v)));
+                }
+            }
+        }, threads);
+    }
+} // namespace Geometry
+
+#endif // SKINNING_H
@@ -0,0 +1,152 @@
+#include "Snapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+namespace Geometry
+{
+    namespace
+    {
+        constexpr std::uint8_t key_frame_flag = 1;
+        constexpr std::size_t header_size = 5;
+        /// Key frames are deltas against the middle of the quantizer box: their zigzag codes fit
+        /// in 16 bits, and in fewer when the positions stay near the middle.
+        constexpr QuantizedPosition key_frame_reference{{32768, 32768, 32768}};
+
+        /// Bit i of a bit plane belongs to value i of the block.
+        constexpr auto lane_bits = [] {
+            std::array<std::uint32_t, snapshot_block_size> bits{};
+            for (std::size_t i = 0; i < snapshot_block_size; ++i) {
+                bits[i] = std::uint32_t{1} << i;
+            }
+            return bits;
+        }();
+
+        /**
+         * Pack one block of `snapshot_block_size` values as `width` bit planes of 4 bytes each,
+         * plane b holding bit b of every value. The lane loops have constant trip counts and
+         * no variable shifts, so they vectorize with SSE2 already.
+         */
+        void pack_block(const std::uint32_t *values, unsigned int width, std::uint8_t *out) {
+            for (auto b = 0u; b < width; ++b) {
+                std::uint32_t plane = 0;
+                for (std::size_t i = 0; i < snapshot_block_size; ++i) {
+                    plane |= lane_bits[i] & (0 - ((values[i] >> b) & 1));
+                }
+                for (auto k = 0u; k < 4; ++k) {
+                    out[4 * b + k] = static_cast<std::uint8_t>(plane >> (8 * k));
+                }
+            }
+        }
+
+        void unpack_block(const std::uint8_t *in, unsigned int width, std::uint32_t *values) {
+            // Most significant plane first, shifting each value left as its bits come in.
+            std::array<std::uint32_t, snapshot_block_size> block{};
+            for (auto b = width; b-- > 0;) {
+                const auto plane = std::uint32_t{in[4 * b]} | (std::uint32_t{in[4 * b + 1]} << 8)
+                                   | (std::uint32_t{in[4 * b + 2]} << 16) | (std::uint32_t{in[4 * b + 3]} << 24);
+                for (std::size_t i = 0; i < snapshot_block_size; ++i) {
+                    block[i] = (block[i] << 1) | static_cast<std::uint32_t>((plane & lane_bits[i]) != 0);
+                }
+            }
+            std::copy(block.begin(), block.end(), values);
+        }
+
+        std::size_t block_count(std::size_t count) {
+            return (count + snapshot_block_size - 1) / snapshot_block_size;
+        }
+    } // namespace
+
+    std::size_t SnapshotEncoder::encode(std::span<const Vector3f> positions, std::vector<std::uint8_t> &out) {
+        const auto count = positions.size();
+        const bool key_frame = _previous.size() != count;
+        if (key_frame) {
+            _previous.assign(count, key_frame_reference);
+        }
+
+        const auto start = out.size();
+        const auto count32 = static_cast<std::uint32_t>(count);
+        out.push_back(static_cast<std::uint8_t>(count32));
+        out.push_back(static_cast<std::uint8_t>(count32 >> 8));
+        out.push_back(static_cast<std::uint8_t>(count32 >> 16));
+        out.push_back(static_cast<std::uint8_t>(count32 >> 24));
+        out.push_back(key_frame ? key_frame_flag : 0);
+
+        // Padding codes stay zero so the last block packs like any other.
+        _codes.assign(block_count(count) * snapshot_block_size, 0);
+        _current.resize(count);
+        _quantizer.encode(positions, _current);
+        for (auto c = 0u; c < 3; ++c) {
+            for (std::size_t i = 0; i < count; ++i) {
+                _codes[i] = zigzag_encode(static_cast<std::int32_t>(_current[i].bits[c]) - _previous[i].bits[c]);
+            }
+            for (std::size_t b = 0; b < _codes.size(); b += snapshot_block_size) {
+                const auto *block = _codes.data() + b;
+                // The widest code has the highest set bit of all of them.
+                std::uint32_t all_bits = 0;
+                for (std::size_t i = 0; i < snapshot_block_size; ++i) {
+                    all_bits |= block[i];
+                }
+                const auto width = static_cast<unsigned int>(std::bit_width(all_bits));
+                out.push_back(static_cast<std::uint8_t>(width));
+                const auto offset = out.size();
+                out.resize(offset + 4 * width);
+                pack_block(block, width, out.data() + offset);
+            }
+        }
+        std::swap(_previous, _current);
+        return out.size() - start;
+    }
+
+    std::size_t SnapshotDecoder::decode(std::span<const std::uint8_t> packet, std::vector<Vector3f> &positions) {
+        if (packet.size() < header_size) {
+            throw std::runtime_error("Snapshot packet is truncated.");
+        }
+        const std::size_t count = packet[0] | (std::uint32_t{packet[1]} << 8) | (std::uint32_t{packet[2]} << 16)
+                                  | (std::uint32_t{packet[3]} << 24);
+        const bool key_frame = (packet[4] & key_frame_flag) != 0;
+        // Every block takes at least its width byte: reject a forged count before allocating.
+        if ((packet.size() - header_size) / 3 < block_count(count)) {
+            throw std::runtime_error("Snapshot packet is truncated.");
+        }
+        if (key_frame) {
+            _previous.assign(count, key_frame_reference);
+        } else if (_previous.size() != count) {
+            throw std::runtime_error("Delta snapshot does not match the previous snapshot.");
+        }
+
+        std::size_t pos = header_size;
+        _codes.resize(block_count(count) * snapshot_block_size);
+        for (auto c = 0u; c < 3; ++c) {
+            for (std::size_t b = 0; b < _codes.size(); b += snapshot_block_size) {
+                if (pos >= packet.size()) {
+                    throw std::runtime_error("Snapshot packet is truncated.");
+                }
+                const unsigned int width = packet[pos++];
+                if (width > 32 || pos + 4 * width > packet.size()) {
+                    throw std::runtime_error("Snapshot packet is corrupted.");
+                }
+                unpack_block(packet.data() + pos, width, _codes.data() + b);
+                pos += 4 * width;
+            }
+            // Checked once after the loop, which a throw inside would keep from vectorizing; the
+            // decoder needs a reset() after an error anyway.
+            std::uint32_t out_of_range = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto q = static_cast<std::int32_t>(_previous[i].bits[c]) + zigzag_decode(_codes[i]);
+                out_of_range |= static_cast<std::uint32_t>(q) >> 16;
+                _previous[i].bits[c] = static_cast<std::uint16_t>(q);
+            }
+            if (out_of_range != 0) {
+                throw std::runtime_error("Snapshot packet is corrupted.");
+            }
+        }
+
+        positions.resize(count);
+        _quantizer.decode(_previous, positions);
+        return pos;
+    }
+} // namespace Geometry
@@ -0,0 +1,112 @@
+/**
+ * @file Snapshot.h
+ * @brief Delta compression of Vector3f position snapshots for state streaming.
+ *
+ * Each tick the encoder:
+ *  1. quantizes positions to 16 bits per component with a shared `PositionQuantizer`,
+ *  2. subtracts the previously sent quantized snapshot (component-major: all x, then all y,
+ *     then all z, so runs of similar deltas stay together); key frames subtract the middle
+ *     of the quantizer box instead, so their codes never exceed 16 bits,
+ *  3. zigzag-maps the signed deltas and bit-packs them in blocks of 32 values, each block
+ *     using the smallest width that fits its largest value. A block of width w is stored as
+ *     w bit planes: plane b holds bit b of all 32 values, which turns packing and unpacking
+ *     into lane-parallel loops that GCC vectorizes (SSE2 and up).
+ * The decoder mirrors the same state, so encoder and decoder must see the same sequence of
+ * snapshots. When the particle count changes the encoder emits a key frame automatically;
+ * `reset()` forces one, e.g. when a client joins.
+ *
+ * Wire format (little endian):
+ *   u32 count | u8 flags (bit 0: key frame) | 3 * ceil(count / 32) blocks
+ *   block = u8 width | width * u32 bit planes (bit i of plane b: bit b of value i)
+ *
+ * `bench snapshot` (bench/Snapshot.cpp) streams 100K particles drifting about 1 cm per tick
+ * in a 200 m box. The data is synthetic (uniform positions, constant velocities), not a
+ * recorded capture, so real game state will compress differently. One core, g++ 12 -O3, it
+ * encodes 900-1050 MB/s of raw Vector3f positions and decodes 1250-1450 MB/s (1900-2250 and
+ * 2100-2900 MB/s with -march=native, AVX2). Key frames are 1.97x smaller than the raw
+ * positions (16 bits per component plus one width byte per block), delta frames 9.8x.
+ * Requires C++20
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Quantize.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /// @brief Number of values sharing one bit width in the packed stream.
+    inline constexpr std::size_t snapshot_block_size = 32;
+
+    /// @brief Map a signed integer to unsigned so that small magnitudes give small codes.
+    constexpr std::uint32_t zigzag_encode(std::int32_t value) {
+        return (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+    }
+
+    /// @brief Inverse of `zigzag_encode`.
+    constexpr std::int32_t zigzag_decode(std::uint32_t code) {
+        return static_cast<std::int32_t>(code >> 1) ^ -static_cast<std::int32_t>(code & 1);
+    }
+
+    /**
+     * @class SnapshotEncoder
+     * @brief Stateful encoder producing one packet per snapshot.
+     */
+    class SnapshotEncoder {
+    public:
+        explicit SnapshotEncoder(const PositionQuantizer<float> &quantizer) : _quantizer(quantizer) {
+        }
+
+        /**
+         * @brief Encode `positions` against the previous snapshot and append the packet to `out`.
+         * @return Number of bytes appended.
+         */
+        std::size_t encode(std::span<const Vector3f> positions, std::vector<std::uint8_t> &out);
+
+        /// @brief Forget the previous snapshot: the next packet is a key frame.
+        void reset() {
+            _previous.clear();
+        }
+
+    private:
+        PositionQuantizer<float> _quantizer;
+        std::vector<QuantizedPosition> _previous;
+        std::vector<QuantizedPosition> _current;
+        std::vector<std::uint32_t> _codes;
+    };
+
+    /**
+     * @class SnapshotDecoder
+     * @brief Stateful decoder reconstructing positions from `SnapshotEncoder` packets.
+     */
+    class SnapshotDecoder {
+    public:
+        explicit SnapshotDecoder(const PositionQuantizer<float> &quantizer) : _quantizer(quantizer) {
+        }
+
+        /**
+         * @brief Decode one packet from the front of `packet` into `positions` (resized).
+         * @return Number of bytes consumed.
+         * @throws std::runtime_error on a truncated or inconsistent packet; call `reset()` and
+         *         wait for a key frame afterwards.
+         */
+        std::size_t decode(std::span<const std::uint8_t> packet, std::vector<Vector3f> &positions);
+
+        /// @brief Forget the previous snapshot; the next packet must be a key frame.
+        void reset() {
+            _previous.clear();
+        }
+
+    private:
+        PositionQuantizer<float> _quantizer;
+        std::vector<QuantizedPosition> _previous;
+        std::vector<std::uint32_t> _codes;
+    };
+} // namespace Geometry
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,147 @@
+/**
+ * @file SoA.h
+ * @brief Structure-of-arrays view over vector components.
+ *
+ * `SoASpan<Dim, T>` refers to `Dim` separate component arrays (x[], y[], z[]...) of equal
+ * length, the layout SIMD kernels prefer. It does not own memory.
+ * Requires C++20
+ */
+
+#ifndef SOA_H
+#define SOA_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "Vector.h"
+
+namespace Geometry {
+    /**
+     * @class SoASpan
+     * @brief Non-owning view over `Dim` component arrays of equal length.
+     *
+     * @tparam Dim The dimension of the viewed vectors.
+     * @tparam T The scalar type, const-qualified for read-only views.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_arithmetic_v<std::remove_const_t<T>>
+    class SoASpan {
+    public:
+        using value_type = Vector<Dim, std::remove_const_t<T>>;
+
+        constexpr SoASpan() = default;
+
+        /// @brief View over the given component arrays, which must all have the same length.
+        constexpr explicit SoASpan(const std::array<std::span<T>, Dim> &components) : _components(components) {
+            for (auto c = 1u; c < Dim; ++c) {
+                assert(_components[c].size() == _components[0].size() && "SoA components must have the same length.");
+            }
+        }
+
+        /// @brief Constructor with Dim component spans.
+        template<typename... Spans>
+            requires (sizeof...(Spans) == Dim && (std::is_constructible_v<std::span<T>, Spans> && ...))
+        constexpr explicit SoASpan(Spans &&... components) : SoASpan(std::array<std::span<T>, Dim>{
+            std::span<T>(std::forward<Spans>(components))...
+        }) {
+        }
+
+        /// @brief Read-only view of a mutable SoA span.
+        constexpr operator SoASpan<Dim, const T>() const requires (!std::is_const_v<T>) {
+            std::array<std::span<const T>, Dim> components;
+            for (auto c = 0u; c < Dim; ++c) {
+                components[c] = _components[c];
+            }
+            return SoASpan<Dim, const T>(components);
+        }
+
+        /// @brief Number of vectors in the view.
+        [[nodiscard]] constexpr std::size_t size() const {
+            return Dim == 0 ? 0 : _components[0].size();
+        }
+
+        /// @brief Component array `c` (0 = x, 1 = y, ...).
+        [[nodiscard]] constexpr std::span<T> component(unsigned int c) const {
+            return _components[c];
+        }
+
+        /// @brief Assemble vector `i` from the component arrays.
+        [[nodiscard]] constexpr value_type load(std::size_t i) const {
+            value_type v;
+            for (auto c = 0u; c < Dim; ++c) {
+                v[c] = _components[c][i];
+            }
+            return v;
+        }
+
+        /// @brief Scatter vector `v` into slot `i` of the component arrays.
+        constexpr void store(std::size_t i, const value_type &v) const requires (!std::is_const_v<T>) {
+            for (auto c = 0u; c < Dim; ++c) {
+                _components[c][i] = v[c];
+            }
+        }
+
+        /// @brief View over elements [offset, offset + count).
+        [[nodiscard]] constexpr SoASpan subspan(std::size_t offset, std::size_t count) const {
+            std::array<std::span<T>, Dim> components;
+            for (auto c = 0u; c < Dim; ++c) {
+                components[c] = _components[c].subspan(offset, count);
+            }
+            return SoASpan(components);
+        }
+
+    private:
+        std::array<std::span<T>, Dim> _components{};
+    };
+
+    /**
+     * @class SoAArray
+     * @brief Owning structure-of-arrays storage for `Dim`-dimensional vectors.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_arithmetic_v<T>
+    class SoAArray {
+    public:
+        SoAArray() = default;
+
+        /// @brief Storage for `count` zero-initialized vectors.
+        explicit SoAArray(std::size_t count) {
+            resize(count);
+        }
+
+        void resize(std::size_t count) {
+            for (auto &component: _components) {
+                component.resize(count);
+            }
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return Dim == 0 ? 0 : _components[0].size();
+        }
+
+        [[nodiscard]] SoASpan<Dim, T> span() {
+            std::array<std::span<T>, Dim> components;
+            for (auto c = 0u; c < Dim; ++c) {
+                components[c] = _components[c];
+            }
+            return SoASpan<Dim, T>(components);
+        }
+
+        [[nodiscard]] SoASpan<Dim, const T> span() const {
+            std::array<std::span<const T>, Dim> components;
+            for (auto c = 0u; c < Dim; ++c) {
+                components[c] = _components[c];
+            }
+            return SoASpan<Dim, const T>(components);
+        }
+
+    private:
+        std::array<std::vector<T>, Dim> _components;
+    };
+} // namespace Geometry
+
+#endif // SOA_H
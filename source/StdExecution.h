@@ -0,0 +1,49 @@
+/**
+ * @file StdExecution.h
+ * @brief Lets the batched algorithms take the `std::execution` policies.
+ *
+ * Kept out of Parallel.h because libstdc++ builds <execution> on TBB when TBB is installed,
+ * and every program including it then has to link TBB. Include this header, and link TBB
+ * where the standard library needs it, to write
+ * @code
+ * normalize(std::execution::par_unseq, std::span<const Vector3f>(in), std::span<Vector3f>(out));
+ * @endcode
+ * `std::execution::seq` and `unseq` run like `execution::seq`, `par` and `par_unseq` like
+ * `execution::par` with its default thread count and grain.
+ * Requires C++20
+ */
+
+#ifndef STDEXECUTION_H
+#define STDEXECUTION_H
+
+#include <execution>
+
+#include "Parallel.h"
+
+namespace Geometry {
+    template<>
+    struct ExecutionPolicyTraits<std::execution::sequenced_policy> {
+        static constexpr bool is_policy = true;
+        static constexpr bool parallel = false;
+    };
+
+    template<>
+    struct ExecutionPolicyTraits<std::execution::unsequenced_policy> {
+        static constexpr bool is_policy = true;
+        static constexpr bool parallel = false;
+    };
+
+    template<>
+    struct ExecutionPolicyTraits<std::execution::parallel_policy> {
+        static constexpr bool is_policy = true;
+        static constexpr bool parallel = true;
+    };
+
+    template<>
+    struct ExecutionPolicyTraits<std::execution::parallel_unsequenced_policy> {
+        static constexpr bool is_policy = true;
+        static constexpr bool parallel = true;
+    };
+} // namespace Geometry
+
+#endif // STDEXECUTION_H
@@ -0,0 +1,369 @@
+/**
+ * @file Task.h
+ * @brief Awaitable coroutine tasks running geometry jobs on a ThreadPool.
+ *
+ * A `Task<T>` is lazy: it starts when awaited (or passed to `sync_wait` / `when_all`) and
+ * resumes its awaiter when it finishes. Tasks hop onto worker threads with
+ * `co_await pool.schedule()`, split array work across the pool with
+ * `co_await parallel_batch(...)`, and run concurrently with `co_await when_all(...)`.
+ *
+ * Example, overlapping the broad phase of the next frame with the narrow phase of this one:
+ * @code
+ * Task<void> frame(ThreadPool &pool, World &world) {
+ *     std::vector<Task<void>> stages;
+ *     stages.push_back(broad_phase(pool, world.next));
+ *     stages.push_back(narrow_phase(pool, world.current));
+ *     co_await when_all(std::move(stages));
+ * }
+ * sync_wait(frame(pool, world));
+ * @endcode
+ * Requires C++20
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <latch>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Parallel.h"
+#include "ThreadPool.h"
+
+namespace Geometry {
+    template<typename T = void>
+    class Task;
+
+    namespace detail {
+        /// @brief State shared by every task promise: the awaiter to resume and a pending exception.
+        struct TaskPromiseBase {
+            std::coroutine_handle<> continuation = std::noop_coroutine();
+            std::exception_ptr exception;
+
+            struct FinalAwaiter {
+                [[nodiscard]] bool await_ready() const noexcept {
+                    return false;
+                }
+
+                // Symmetric transfer to the awaiter: no stack growth on long await chains.
+                template<typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept {
+                    return handle.promise().continuation;
+                }
+
+                void await_resume() const noexcept {
+                }
+            };
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept {
+                return {};
+            }
+
+            void unhandled_exception() {
+                exception = std::current_exception();
+            }
+        };
+
+        template<typename T>
+        struct TaskPromise : TaskPromiseBase {
+            std::optional<T> value;
+
+            Task<T> get_return_object();
+
+            template<typename U>
+            void return_value(U &&result) {
+                value.emplace(std::forward<U>(result));
+            }
+        };
+
+        template<>
+        struct TaskPromise<void> : TaskPromiseBase {
+            Task<void> get_return_object();
+
+            void return_void() const noexcept {
+            }
+        };
+
+        /// @brief Fire-and-forget coroutine used to start tasks from non-coroutine code.
+        struct DetachedTask {
+            struct promise_type {
+                DetachedTask get_return_object() const noexcept {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() const noexcept {
+                    return {};
+                }
+
+                std::suspend_never final_suspend() const noexcept {
+                    return {};
+                }
+
+                void return_void() const noexcept {
+                }
+
+                void unhandled_exception() const noexcept {
+                    std::terminate();
+                }
+            };
+        };
+    } // namespace detail
+
+    /**
+     * @class Task
+     * @brief Lazily started, single-awaiter coroutine producing a `T`.
+     *
+     * Exceptions thrown by the coroutine body are rethrown in the awaiter.
+     *
+     * @tparam T The result type (void for no result).
+     */
+    template<typename T>
+    class [[nodiscard]] Task {
+    public:
+        using promise_type = detail::TaskPromise<T>;
+
+        explicit Task(std::coroutine_handle<promise_type> handle) : _handle(handle) {
+        }
+
+        Task(const Task &) = delete;
+        Task &operator=(const Task &) = delete;
+
+        Task(Task &&other) noexcept : _handle(std::exchange(other._handle, nullptr)) {
+        }
+
+        Task &operator=(Task &&other) noexcept {
+            if (this != &other) {
+                if (_handle) {
+                    _handle.destroy();
+                }
+                _handle = std::exchange(other._handle, nullptr);
+            }
+            return *this;
+        }
+
+        ~Task() {
+            if (_handle) {
+                _handle.destroy();
+            }
+        }
+
+        auto operator co_await() const noexcept {
+            struct TaskAwaiter {
+                std::coroutine_handle<promise_type> handle;
+
+                [[nodiscard]] bool await_ready() const noexcept {
+                    return handle.done();
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+
+                T await_resume() const {
+                    if (handle.promise().exception) {
+                        std::rethrow_exception(handle.promise().exception);
+                    }
+                    if constexpr (!std::is_void_v<T>) {
+                        return std::move(*handle.promise().value);
+                    }
+                }
+            };
+            return TaskAwaiter{_handle};
+        }
+
+    private:
+        std::coroutine_handle<promise_type> _handle;
+    };
+
+    namespace detail {
+        template<typename T>
+        Task<T> TaskPromise<T>::get_return_object() {
+            return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+        }
+
+        inline Task<void> TaskPromise<void>::get_return_object() {
+            return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+        }
+
+        template<typename T, typename Result>
+        DetachedTask run_and_signal(Task<T> &task, Result &result, std::exception_ptr &error, std::latch &done) {
+            try {
+                if constexpr (std::is_void_v<T>) {
+                    co_await task;
+                } else {
+                    result.emplace(co_await task);
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+            done.count_down();
+        }
+
+        /// @brief Completion state shared by the children of a `when_all` or `parallel_batch`.
+        struct JoinState {
+            std::atomic<std::size_t> pending;
+            std::coroutine_handle<> awaiting;
+            std::mutex error_mutex;
+            std::exception_ptr error;
+
+            explicit JoinState(std::size_t participants = 0) : pending(participants) {
+            }
+
+            void fail(std::exception_ptr e) {
+                std::scoped_lock lock(error_mutex);
+                if (!error) {
+                    error = std::move(e);
+                }
+            }
+
+            /// @brief Mark one participant done; the last one resumes the awaiter.
+            void arrive() {
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    awaiting.resume();
+                }
+            }
+        };
+
+        inline DetachedTask run_child(Task<void> &task, JoinState &state) {
+            try {
+                co_await task;
+            } catch (...) {
+                state.fail(std::current_exception());
+            }
+            state.arrive();
+        }
+    } // namespace detail
+
+    /**
+     * @brief Block the calling thread until `task` completes and return its result.
+     * @note Must not be called from a pool worker waiting on work queued to the same pool.
+     */
+    template<typename T>
+    T sync_wait(Task<T> task) {
+        std::latch done(1);
+        std::exception_ptr error;
+        std::optional<std::conditional_t<std::is_void_v<T>, char, T>> result;
+        detail::run_and_signal(task, result, error, done);
+        done.wait();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*result);
+        }
+    }
+
+    /**
+     * @brief Run every task concurrently and complete when all of them are done.
+     *
+     * Each task starts on the current thread and runs until its first suspension, so tasks
+     * should begin with `co_await pool.schedule()` (or a `parallel_batch`) to actually overlap.
+     * The first exception thrown by any task is rethrown once all tasks are finished.
+     */
+    inline Task<void> when_all(std::vector<Task<void>> tasks) {
+        struct WhenAllAwaiter {
+            std::vector<Task<void>> &tasks;
+            detail::JoinState &state;
+
+            [[nodiscard]] bool await_ready() const noexcept {
+                return tasks.empty();
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiting) const {
+                state.awaiting = awaiting;
+                for (auto &task: tasks) {
+                    detail::run_child(task, state);
+                }
+                // Our own reference: if every child already finished, continue without suspending.
+                return state.pending.fetch_sub(1, std::memory_order_acq_rel) != 1;
+            }
+
+            void await_resume() const noexcept {
+            }
+        };
+
+        detail::JoinState state{tasks.size() + 1};
+        co_await WhenAllAwaiter{tasks, state};
+        if (state.error) {
+            std::rethrow_exception(state.error);
+        }
+    }
+
+    /**
+     * @brief Awaitable splitting `fn(begin, end, chunk)` over `count` elements across the pool.
+     *
+     * Chunks follow `chunk_range`, so the same chunk always covers the same elements.
+     * The awaiting coroutine resumes on the worker that finishes the last chunk; the first
+     * exception thrown by a chunk is rethrown from the `co_await`.
+     *
+     * Example:
+     * @code
+     * co_await parallel_batch(pool, points.size(), [&](std::size_t begin, std::size_t end, unsigned int) {
+     *     for (auto i = begin; i < end; ++i) points[i] = points[i].normalized();
+     * });
+     * @endcode
+     *
+     * @param chunks Number of jobs to queue (defaults to the pool size, clamped to [1, count]).
+     */
+    template<typename Fn>
+    auto parallel_batch(ThreadPool &pool, std::size_t count, Fn fn, unsigned int chunks = 0) {
+        struct BatchAwaiter {
+            ThreadPool &pool;
+            std::size_t count;
+            Fn fn;
+            unsigned int chunks;
+            detail::JoinState state{};
+
+            [[nodiscard]] bool await_ready() const noexcept {
+                return count == 0;
+            }
+
+            void await_suspend(std::coroutine_handle<> awaiting) {
+                state.awaiting = awaiting;
+                state.pending.store(chunks, std::memory_order_relaxed);
+                // The last chunk may resume (and destroy) this awaiter before the loop ends:
+                // only locals are touched after the first submit.
+                auto &target_pool = pool;
+                const auto chunk_count = chunks;
+                for (unsigned int c = 0; c < chunk_count; ++c) {
+                    target_pool.submit([this, c] {
+                        const auto [begin, end] = chunk_range(count, c, chunks);
+                        try {
+                            fn(begin, end, c);
+                        } catch (...) {
+                            state.fail(std::current_exception());
+                        }
+                        state.arrive();
+                    });
+                }
+            }
+
+            void await_resume() const {
+                if (state.error) {
+                    std::rethrow_exception(state.error);
+                }
+            }
+        };
+
+        if (chunks == 0) {
+            chunks = pool.size();
+        }
+        chunks = static_cast<unsigned int>(std::clamp<std::size_t>(chunks, 1, std::max<std::size_t>(count, 1)));
+        return BatchAwaiter{pool, count, std::move(fn), chunks};
+    }
+} // namespace Geometry
+
+#endif // TASK_H
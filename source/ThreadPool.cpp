@@ -0,0 +1,49 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace Geometry
+{
+    ThreadPool::ThreadPool(unsigned int threads) {
+        threads = std::max(1u, threads);
+        _workers.reserve(threads);
+        for (unsigned int i = 0; i < threads; ++i) {
+            _workers.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::scoped_lock lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (auto &worker: _workers) {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::submit(Job job) {
+        {
+            std::scoped_lock lock(_mutex);
+            _jobs.push_back(std::move(job));
+        }
+        _wake.notify_one();
+    }
+
+    void ThreadPool::worker_loop() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock lock(_mutex);
+                _wake.wait(lock, [this] { return _stopping || !_jobs.empty(); });
+                if (_jobs.empty()) {
+                    return;
+                }
+                job = std::move(_jobs.front());
+                _jobs.pop_front();
+            }
+            job();
+        }
+    }
+} // namespace Geometry
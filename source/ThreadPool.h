@@ -0,0 +1,91 @@
+/**
+ * @file ThreadPool.h
+ * @brief Fixed-size worker pool that runs jobs and resumes coroutines.
+ *
+ * Jobs are executed in FIFO order by a fixed set of workers. Coroutines move onto the pool
+ * with `co_await pool.schedule()`; see Task.h for the awaitable task type built on top.
+ * Requires C++20
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Parallel.h"
+
+namespace Geometry {
+    /**
+     * @class ThreadPool
+     * @brief A fixed set of worker threads consuming a shared job queue.
+     *
+     * The destructor drains the queue: every job submitted before destruction runs.
+     */
+    class ThreadPool {
+    public:
+        using Job = std::function<void()>;
+
+        /// @brief Start `threads` workers (at least one).
+        explicit ThreadPool(unsigned int threads = default_thread_count());
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        /// @brief Finish every queued job, then join the workers.
+        ~ThreadPool();
+
+        /// @brief Queue a job for execution on one of the workers.
+        void submit(Job job);
+
+        /// @brief Number of worker threads.
+        [[nodiscard]] unsigned int size() const {
+            return static_cast<unsigned int>(_workers.size());
+        }
+
+        /**
+         * @brief Awaitable that resumes the awaiting coroutine on a worker thread.
+         *
+         * Example:
+         * @code
+         * Task<void> step(ThreadPool &pool) {
+         *     co_await pool.schedule();
+         *     // Runs on a worker from here on.
+         * }
+         * @endcode
+         */
+        [[nodiscard]] auto schedule() {
+            struct ScheduleAwaiter {
+                ThreadPool &pool;
+
+                [[nodiscard]] bool await_ready() const noexcept {
+                    return false;
+                }
+
+                void await_suspend(std::coroutine_handle<> handle) const {
+                    pool.submit([handle] { handle.resume(); });
+                }
+
+                void await_resume() const noexcept {
+                }
+            };
+            return ScheduleAwaiter{*this};
+        }
+
+    private:
+        void worker_loop();
+
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::deque<Job> _jobs;
+        bool _stopping = false;
+        std::vector<std::thread> _workers;
+    };
+} // namespace Geometry
+
+#endif // THREADPOOL_H
@@ -0,0 +1,359 @@
+/**
+ * @file Transform3.h
+ * @brief Affine 3D transform stored as a 3x4 matrix (linear part + translation).
+ *
+ * A `Matrix<4, 4, T>` spends a fourth row that is always (0, 0, 0, 1) for rigid and affine
+ * transforms. `Transform3` drops it: 12 scalars instead of 16, points cost 9 multiplies
+ * instead of 16, and composition costs 36 multiplies instead of 64. `transform()` overloads
+ * on `Point` and `Direction`, so directions skip the translation column.
+ * Requires C++20
+ */
+
+#ifndef TRANSFORM3_H
+#define TRANSFORM3_H
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <span>
+#include <type_traits>
+
+#include "Matrix.h"
+#include "Parallel.h"
+#include "Point.h"
+#include "Quaternion.h"
+#include "SoA.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /**
+     * @class Transform3
+     * @brief Affine transform x -> L x + t.
+     *
+     * @tparam T The scalar type. Must be floating point.
+     */
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    class Transform3 {
+    private:
+        // Columns 0..2: linear part L, column 3: translation t.
+        Matrix<3, 4, T> _m;
+
+    public:
+        /// @brief Default constructor gives the identity transform.
+        constexpr Transform3() {
+            _m(0, 0) = _m(1, 1) = _m(2, 2) = T(1);
+        }
+
+        /// @brief Transform from a linear part and a translation.
+        constexpr Transform3(const Matrix<3, 3, T> &linear, const Vector<3, T> &translation) {
+            for (auto r = 0u; r < 3; ++r) {
+                for (auto c = 0u; c < 3; ++c) {
+                    _m(r, c) = linear(r, c);
+                }
+                _m(r, 3) = translation[r];
+            }
+        }
+
+        /// @brief Rigid transform: rotation by `rotation`, then translation.
+        Transform3(const Quaternion<T> &rotation, const Vector<3, T> &translation)
+            : Transform3(rotation.to_matrix(), translation) {
+        }
+
+        /// @brief Affine part of a 4x4 matrix (the last row is assumed to be (0, 0, 0, 1)).
+        constexpr explicit Transform3(const Matrix<4, 4, T> &m) {
+            for (auto r = 0u; r < 3; ++r) {
+                for (auto c = 0u; c < 4; ++c) {
+                    _m(r, c) = m(r, c);
+                }
+            }
+        }
+
+        [[nodiscard]] static constexpr Transform3 identity() {
+            return Transform3();
+        }
+
+        [[nodiscard]] static constexpr Transform3 from_translation(const Vector<3, T> &translation) {
+            return Transform3(Matrix<3, 3, T>::identity(), translation);
+        }
+
+        [[nodiscard]] static constexpr Transform3 from_scale(const Vector<3, T> &scale) {
+            Matrix<3, 3, T> linear;
+            for (auto i = 0u; i < 3; ++i) {
+                linear(i, i) = scale[i];
+            }
+            return Transform3(linear, Vector<3, T>());
+        }
+
+        [[nodiscard]] static Transform3 from_rotation(const Quaternion<T> &rotation) {
+            return Transform3(rotation, Vector<3, T>());
+        }
+
+        /// @brief Linear part L.
+        [[nodiscard]] constexpr Matrix<3, 3, T> linear() const {
+            Matrix<3, 3, T> linear;
+            for (auto r = 0u; r < 3; ++r) {
+                for (auto c = 0u; c < 3; ++c) {
+                    linear(r, c) = _m(r, c);
+                }
+            }
+            return linear;
+        }
+
+        /// @brief Translation t.
+        [[nodiscard]] constexpr Vector<3, T> translation() const {
+            return _m.col(3);
+        }
+
+        /// @brief Rotation of a rigid transform (L must be orthonormal).
+        [[nodiscard]] Quaternion<T> rotation() const {
+            return Quaternion<T>::from_matrix(linear());
+        }
+
+        /// @brief Underlying 3x4 matrix.
+        [[nodiscard]] constexpr const Matrix<3, 4, T> &matrix() const {
+            return _m;
+        }
+
+        /// @brief Equivalent 4x4 homogeneous matrix.
+        [[nodiscard]] constexpr Matrix<4, 4, T> to_matrix4() const {
+            Matrix<4, 4, T> m;
+            for (auto r = 0u; r < 3; ++r) {
+                for (auto c = 0u; c < 4; ++c) {
+                    m(r, c) = _m(r, c);
+                }
+            }
+            m(3, 3) = T(1);
+            return m;
+        }
+
+        /// @brief Transform a point: L p + t.
+        [[nodiscard]] constexpr Vector<3, T> transform_point(const Vector<3, T> &p) const {
+            return Vector<3, T>(
+                _m(0, 0) * p[0] + _m(0, 1) * p[1] + _m(0, 2) * p[2] + _m(0, 3),
+                _m(1, 0) * p[0] + _m(1, 1) * p[1] + _m(1, 2) * p[2] + _m(1, 3),
+                _m(2, 0) * p[0] + _m(2, 1) * p[1] + _m(2, 2) * p[2] + _m(2, 3)
+            );
+        }
+
+        /// @brief Transform a direction (no translation): L v.
+        [[nodiscard]] constexpr Vector<3, T> transform_vector(const Vector<3, T> &v) const {
+            return Vector<3, T>(
+                _m(0, 0) * v[0] + _m(0, 1) * v[1] + _m(0, 2) * v[2],
+                _m(1, 0) * v[0] + _m(1, 1) * v[1] + _m(1, 2) * v[2],
+                _m(2, 0) * v[0] + _m(2, 1) * v[1] + _m(2, 2) * v[2]
+            );
+        }
+
+        /// @brief Transform a point: L p + t.
+        [[nodiscard]] constexpr Point<3, T> transform(const Point<3, T> &p) const {
+            return Point<3, T>(transform_point(p.vector()));
+        }
+
+        /// @brief Transform a direction: L d, no translation.
+        [[nodiscard]] constexpr Direction<3, T> transform(const Direction<3, T> &d) const {
+            return Direction<3, T>(transform_vector(d.vector()));
+        }
+
+        /**
+         * @brief Matrix transforming normals: the inverse transpose of L.
+         * @note For rigid transforms this is L itself; use `transform_vector` instead.
+         */
+        [[nodiscard]] Matrix<3, 3, T> normal_matrix() const {
+            return inverse_linear().transposed();
+        }
+
+        /**
+         * @brief Transform a normal with the inverse transpose of L (not renormalized).
+         * @note Computes the inverse on every call; batch with `transform_normals`.
+         */
+        [[nodiscard]] Vector<3, T> transform_normal(const Vector<3, T> &n) const {
+            return normal_matrix() * n;
+        }
+
+        /**
+         * @brief Composition: (a * b)(x) = a(b(x)).
+         */
+        [[nodiscard]] constexpr Transform3 operator*(const Transform3 &other) const {
+            Transform3 result;
+            for (auto r = 0u; r < 3; ++r) {
+                for (auto c = 0u; c < 4; ++c) {
+                    result._m(r, c) = _m(r, 0) * other._m(0, c) + _m(r, 1) * other._m(1, c)
+                                      + _m(r, 2) * other._m(2, c);
+                }
+                result._m(r, 3) += _m(r, 3);
+            }
+            return result;
+        }
+
+        /**
+         * @brief General affine inverse: (L^-1, -L^-1 t).
+         * @warning L must be invertible.
+         */
+        [[nodiscard]] Transform3 inverse() const {
+            const auto inv = inverse_linear();
+            return Transform3(inv, inv * translation() * T(-1));
+        }
+
+        /**
+         * @brief Inverse of a rigid transform: (L^T, -L^T t).
+         * @warning Only valid if L is a rotation (orthonormal); this is not checked.
+         */
+        [[nodiscard]] constexpr Transform3 rigid_inverse() const {
+            const auto rt = linear().transposed();
+            return Transform3(rt, rt * translation() * T(-1));
+        }
+
+        /// @brief Transform every point of a span: out[i] = L in[i] + t.
+        void transform_points(std::span<const Vector<3, T>> in, std::span<Vector<3, T>> out) const {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = transform_point(in[i]);
+            }
+        }
+
+        /// @brief Transform every direction of a span: out[i] = L in[i].
+        void transform_vectors(std::span<const Vector<3, T>> in, std::span<Vector<3, T>> out) const {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = transform_vector(in[i]);
+            }
+        }
+
+        /// @brief Transform every point of a span: out[i] = L in[i] + t.
+        void transform(std::span<const Point<3, T>> in, std::span<Point<3, T>> out) const {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = transform(in[i]);
+            }
+        }
+
+        /// @brief Transform every direction of a span: out[i] = L in[i].
+        void transform(std::span<const Direction<3, T>> in, std::span<Direction<3, T>> out) const {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                out[i] = transform(in[i]);
+            }
+        }
+
+        /// @brief Transform every normal of a span; the normal matrix is computed once.
+        void transform_normals(std::span<const Vector<3, T>> in, std::span<Vector<3, T>> out) const {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            const Transform3 normal(normal_matrix(), Vector<3, T>());
+            normal.transform_vectors(in, out);
+        }
+
+        /**
+         * @name Span transforms with an execution policy
+         * Split across threads as `policy` allows; see `policy_thread_count` in Parallel.h.
+         * @{
+         */
+        template<ExecutionPolicy Policy>
+        void transform_points(const Policy &policy, std::span<const Vector<3, T>> in,
+                              std::span<Vector<3, T>> out) const {
+            split(policy, in, out, [this](auto piece_in, auto piece_out) { transform_points(piece_in, piece_out); });
+        }
+
+        template<ExecutionPolicy Policy>
+        void transform_vectors(const Policy &policy, std::span<const Vector<3, T>> in,
+                               std::span<Vector<3, T>> out) const {
+            split(policy, in, out, [this](auto piece_in, auto piece_out) { transform_vectors(piece_in, piece_out); });
+        }
+
+        template<ExecutionPolicy Policy>
+        void transform(const Policy &policy, std::span<const Point<3, T>> in, std::span<Point<3, T>> out) const {
+            split(policy, in, out, [this](auto piece_in, auto piece_out) { transform(piece_in, piece_out); });
+        }
+
+        template<ExecutionPolicy Policy>
+        void transform(const Policy &policy, std::span<const Direction<3, T>> in,
+                       std::span<Direction<3, T>> out) const {
+            split(policy, in, out, [this](auto piece_in, auto piece_out) { transform(piece_in, piece_out); });
+        }
+
+        template<ExecutionPolicy Policy>
+        void transform_normals(const Policy &policy, std::span<const Vector<3, T>> in,
+                               std::span<Vector<3, T>> out) const {
+            const Transform3 normal(normal_matrix(), Vector<3, T>());
+            normal.transform_vectors(policy, in, out);
+        }
+
+        /** @} */
+
+        /**
+         * @brief Transform points stored as SoA; the loop runs over contiguous component arrays
+         *        so the compiler vectorizes it across elements. `in` and `out` may alias.
+         */
+        void transform_points(SoASpan<3, const T> in, SoASpan<3, T> out) const {
+            transform_soa<true>(in, out);
+        }
+
+        /// @brief Transform directions stored as SoA; the translation is neither loaded nor added.
+        void transform_vectors(SoASpan<3, const T> in, SoASpan<3, T> out) const {
+            transform_soa<false>(in, out);
+        }
+
+        /// @brief Equality operator (element-wise).
+        constexpr bool operator==(const Transform3 &other) const {
+            return _m == other._m;
+        }
+
+        /// @brief Pretty print a transform.
+        friend std::ostream &operator<<(std::ostream &os, const Transform3 &t) {
+            return os << "Transform3[" << t.linear() << ';' << t.translation() << ']';
+        }
+
+    private:
+        /// Run the span function `batch` on the pieces of `in` and `out` given to each thread.
+        template<typename Policy, typename In, typename Out, typename Batch>
+        void split(const Policy &policy, std::span<const In> in, std::span<Out> out, Batch &&batch) const {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            parallel_for(policy, in.size(), element_cost_ns::transform3, [&](std::size_t begin, std::size_t end, unsigned int) {
+                batch(in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+            });
+        }
+
+        [[nodiscard]] Matrix<3, 3, T> inverse_linear() const {
+            // Adjugate / determinant; the rows of the adjugate are cross products of columns.
+            const auto c0 = _m.col(0), c1 = _m.col(1), c2 = _m.col(2);
+            const auto r0 = c1.cross(c2), r1 = c2.cross(c0), r2 = c0.cross(c1);
+            const auto det = c0.dot(r0);
+            assert(det != 0 && "Cannot invert a singular transform.");
+            const auto inv_det = T(1) / det;
+            return Matrix<3, 3, T>(
+                r0[0] * inv_det, r0[1] * inv_det, r0[2] * inv_det,
+                r1[0] * inv_det, r1[1] * inv_det, r1[2] * inv_det,
+                r2[0] * inv_det, r2[1] * inv_det, r2[2] * inv_det
+            );
+        }
+
+        template<bool Translate>
+        void transform_soa(SoASpan<3, const T> in, SoASpan<3, T> out) const {
+            assert(out.size() >= in.size() && "Output span is too small.");
+            const auto x = in.component(0), y = in.component(1), z = in.component(2);
+            const auto ox = out.component(0), oy = out.component(1), oz = out.component(2);
+            for (std::size_t i = 0; i < in.size(); ++i) {
+                // Read all components first so that `in` and `out` may alias.
+                const auto px = x[i], py = y[i], pz = z[i];
+                auto rx = _m(0, 0) * px + _m(0, 1) * py + _m(0, 2) * pz;
+                auto ry = _m(1, 0) * px + _m(1, 1) * py + _m(1, 2) * pz;
+                auto rz = _m(2, 0) * px + _m(2, 1) * py + _m(2, 2) * pz;
+                if constexpr (Translate) {
+                    rx += _m(0, 3);
+                    ry += _m(1, 3);
+                    rz += _m(2, 3);
+                }
+                ox[i] = rx;
+                oy[i] = ry;
+                oz[i] = rz;
+            }
+        }
+    };
+
+    // Typedefs for common use cases.
+    using Transform3f = Transform3<float>;
+    using Transform3d = Transform3<double>;
+} // namespace Geometry
+
+#endif // TRANSFORM3_H
@@ -0,0 +1,202 @@
+/**
+ * @file TransformHierarchy.h
+ * @brief Flat scene hierarchy with incremental local-to-world propagation.
+ *
+ * Nodes live in flat arrays (parent index, local transform, world transform, dirty flag)
+ * ordered parent-before-child, so a single forward sweep computes every world transform
+ * from an already up-to-date parent, reading memory linearly.
+ *
+ * Updates are incremental: `set_local` marks a node dirty and the next `update()` only
+ * recomputes dirty nodes and their descendants, starting the sweep at the first dirty node.
+ *
+ * After `sort_by_level()` nodes are additionally grouped by depth, so every level is a
+ * contiguous range whose nodes only depend on the previous level; `update(threads)` then
+ * processes each sufficiently large level in parallel.
+ * Requires C++20
+ */
+
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "Parallel.h"
+#include "Transform3.h"
+
+namespace Geometry {
+    /**
+     * @class TransformHierarchy
+     * @brief Parent-before-child array of transforms with dirty-flag propagation.
+     *
+     * @tparam T The scalar type of the transforms.
+     */
+    template<typename T>
+    class TransformHierarchy {
+    public:
+        using NodeId = std::uint32_t;
+        static constexpr NodeId no_parent = std::numeric_limits<NodeId>::max();
+
+        /// @brief Levels smaller than this are processed on the calling thread.
+        static constexpr std::size_t parallel_level_threshold = 4096;
+
+        /**
+         * @brief Append a node; `parent` must already exist (or be `no_parent` for a root).
+         * @return Index of the new node.
+         */
+        NodeId add_node(const Transform3<T> &local, NodeId parent = no_parent) {
+            assert((parent == no_parent || parent < size()) && "Parent must be added before its children.");
+            const auto id = static_cast<NodeId>(size());
+            const auto depth = parent == no_parent ? 0u : _depth[parent] + 1;
+            if (_level_sorted && id > 0 && depth < _depth.back()) {
+                _level_sorted = false;
+            }
+            _parent.push_back(parent);
+            _depth.push_back(depth);
+            _local.push_back(local);
+            _world.push_back(local);
+            _dirty.push_back(1);
+            _first_dirty = std::min<std::size_t>(_first_dirty, id);
+            return id;
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return _parent.size();
+        }
+
+        [[nodiscard]] NodeId parent(NodeId node) const {
+            return _parent[node];
+        }
+
+        [[nodiscard]] const Transform3<T> &local(NodeId node) const {
+            return _local[node];
+        }
+
+        /// @brief World transform as of the last `update()`.
+        [[nodiscard]] const Transform3<T> &world(NodeId node) const {
+            return _world[node];
+        }
+
+        /// @brief Replace a local transform; the node and its subtree are recomputed on `update()`.
+        void set_local(NodeId node, const Transform3<T> &local) {
+            _local[node] = local;
+            _dirty[node] = 1;
+            _first_dirty = std::min<std::size_t>(_first_dirty, node);
+        }
+
+        /// @brief True if nodes are grouped by depth and `update()` can run level-parallel.
+        [[nodiscard]] bool level_sorted() const {
+            return _level_sorted;
+        }
+
+        /**
+         * @brief Reorder nodes by depth (stable), keeping parent-before-child order.
+         * @return Mapping old index -> new index, to update handles held by the caller.
+         */
+        std::vector<NodeId> sort_by_level() {
+            const auto count = size();
+            const auto levels = count == 0 ? 0 : *std::max_element(_depth.begin(), _depth.end()) + 1;
+            std::vector<std::size_t> offsets(levels + 1, 0);
+            for (const auto d: _depth) {
+                ++offsets[d + 1];
+            }
+            for (std::size_t l = 0; l < levels; ++l) {
+                offsets[l + 1] += offsets[l];
+            }
+
+            std::vector<NodeId> remap(count);
+            auto cursor = offsets;
+            for (std::size_t i = 0; i < count; ++i) {
+                remap[i] = static_cast<NodeId>(cursor[_depth[i]]++);
+            }
+
+            std::vector<NodeId> parent(count);
+            std::vector<std::uint32_t> depth(count);
+            std::vector<Transform3<T>> local(count), world(count);
+            std::vector<std::uint8_t> dirty(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto j = remap[i];
+                parent[j] = _parent[i] == no_parent ? no_parent : remap[_parent[i]];
+                depth[j] = _depth[i];
+                local[j] = _local[i];
+                world[j] = _world[i];
+                dirty[j] = _dirty[i];
+            }
+            _parent = std::move(parent);
+            _depth = std::move(depth);
+            _local = std::move(local);
+            _world = std::move(world);
+            _dirty = std::move(dirty);
+            _level_sorted = true;
+            _first_dirty = 0;
+            return remap;
+        }
+
+        /**
+         * @brief Recompute the world transform of every dirty node and its descendants.
+         * @param threads Worker threads used for large levels; requires `level_sorted()`,
+         *                otherwise the update runs on the calling thread.
+         */
+        void update(unsigned int threads = 1) {
+            const auto count = size();
+            if (_first_dirty >= count) {
+                return;
+            }
+
+            if (threads <= 1 || !_level_sorted) {
+                update_range(_first_dirty, count);
+            } else {
+                // Level boundaries: nodes are grouped by depth, so scan for depth changes.
+                auto begin = _first_dirty;
+                while (begin < count) {
+                    auto end = begin + 1;
+                    while (end < count && _depth[end] == _depth[begin]) {
+                        ++end;
+                    }
+                    if (end - begin < parallel_level_threshold) {
+                        update_range(begin, end);
+                    } else {
+                        parallel_for(end - begin, [&](std::size_t first, std::size_t last, unsigned int) {
+                            update_range(begin + first, begin + last);
+                        }, threads);
+                    }
+                    begin = end;
+                }
+            }
+
+            std::fill(_dirty.begin() + static_cast<std::ptrdiff_t>(_first_dirty), _dirty.end(), 0);
+            _first_dirty = count;
+        }
+
+    private:
+        /// Nodes in [begin, end) only read parents outside the range or earlier in it.
+        void update_range(std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                const auto p = _parent[i];
+                if (p == no_parent) {
+                    if (_dirty[i]) {
+                        _world[i] = _local[i];
+                    }
+                } else if (_dirty[i] || _dirty[p]) {
+                    // Flag the node so its own children see the change.
+                    _dirty[i] = 1;
+                    _world[i] = _world[p] * _local[i];
+                }
+            }
+        }
+
+        std::vector<NodeId> _parent;
+        std::vector<std::uint32_t> _depth;
+        std::vector<Transform3<T>> _local;
+        std::vector<Transform3<T>> _world;
+        std::vector<std::uint8_t> _dirty;
+        std::size_t _first_dirty = 0;
+        bool _level_sorted = true;
+    };
+} // namespace Geometry
+
+#endif // TRANSFORMHIERARCHY_H
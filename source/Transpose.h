@@ -0,0 +1,444 @@
+/**
+ * @file Transpose.h
+ * @brief AoS <-> SoA conversion of 3D and 4D vector arrays with SIMD shuffles.
+ *
+ * `aos_to_soa` splits `std::span<const Vector<Dim, T>>` into the component arrays of a
+ * `SoASpan`, `soa_to_aos` interleaves them back. Float and double vectors of dimension 3
+ * and 4 go through register transposes:
+ *  - 3D: three loads hold 4 (SSE float, AVX double) or 8 (AVX float) vectors, which
+ *    in-lane shuffles split into x, y and z registers, and back;
+ *  - 4D: 4x4 transposes with unpack / shuffle (SSE) or unpack / permute (AVX double),
+ *    and two 4x4 transposes side by side in the 128-bit lanes of AVX registers for 8
+ *    float vectors per step.
+ * Other dimensions and scalar types, and the last few elements, use a per-element loop.
+ * The SSE paths need only SSE2, which every x86-64 target has; build with -mavx for the
+ * AVX ones.
+ *
+ * `StorePolicy::NonTemporal` writes the output with streaming stores, which skip the
+ * cache: for arrays larger than the last-level cache that will not be read back soon,
+ * this saves the read-for-ownership traffic of the destination. The destination is
+ * aligned by converting a few leading elements one by one; if the SoA component arrays
+ * have different alignments, regular stores are used instead.
+ *
+ * GB/s of input + output moved for Vector3f, one core, g++ 12 -O3, medians of four runs of
+ * `bench transpose` (bench/Transpose.cpp) in the default build (SSE2) and with
+ * -DBENCH_NATIVE=ON (AVX2 machine); runs differ by up to 30% in cache. "Loop" is the plain
+ * per-element copy; at -O3 -march=native GCC vectorizes it with AVX2 permutes, which is
+ * why it catches up there:
+ *
+ * | Conversion      | Size       | Loop, SSE2 | SSE2 | Loop, AVX2 | AVX | AVX, non-temporal |
+ * |-----------------|------------|------------|------|------------|-----|-------------------|
+ * | Vector3f -> SoA | 16K (L2)   | 15         | 20   | 33         | 31  | 32                |
+ * | SoA -> Vector3f | 16K (L2)   | 19         | 50   | 47         | 54  | 16                |
+ * | Vector3f -> SoA | 16M (DRAM) | 10         | 11   | 10         | 10  | 10                |
+ * | SoA -> Vector3f | 16M (DRAM) | 10         | 11   | 11         | 11  | 11 - 16           |
+ *
+ * Streaming stores do not pay off in cache, where the output is evicted; for arrays in
+ * DRAM they break even, and only the single AoS output stream sometimes gains.
+ * Requires C++20
+ */
+
+#ifndef TRANSPOSE_H
+#define TRANSPOSE_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define GEOMETRY_TRANSPOSE_SSE2 1
+#endif
+
+#include "SoA.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /// @brief How the conversions write their output.
+    enum class StorePolicy {
+        /// Regular stores, the output stays in cache.
+        Cached,
+        /// Streaming stores that bypass the cache, for outputs larger than the cache.
+        NonTemporal
+    };
+
+    namespace detail {
+#if defined(GEOMETRY_TRANSPOSE_SSE2)
+        template<bool Stream>
+        inline void store(float *p, __m128 v) {
+            if constexpr (Stream) {
+                _mm_stream_ps(p, v);
+            } else {
+                _mm_storeu_ps(p, v);
+            }
+        }
+
+        template<bool Stream>
+        inline void store(double *p, __m128d v) {
+            if constexpr (Stream) {
+                _mm_stream_pd(p, v);
+            } else {
+                _mm_storeu_pd(p, v);
+            }
+        }
+#endif
+#if defined(__AVX__)
+        template<bool Stream>
+        inline void store(float *p, __m256 v) {
+            if constexpr (Stream) {
+                _mm256_stream_ps(p, v);
+            } else {
+                _mm256_storeu_ps(p, v);
+            }
+        }
+
+        template<bool Stream>
+        inline void store(double *p, __m256d v) {
+            if constexpr (Stream) {
+                _mm256_stream_pd(p, v);
+            } else {
+                _mm256_storeu_pd(p, v);
+            }
+        }
+
+        /// Two 128-bit loads into the low and high lanes of one register.
+        inline __m256 load_lanes(const float *lo, const float *hi) {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+        }
+
+        /// Store the low and high lanes of a register to two addresses.
+        template<bool Stream>
+        inline void store_lanes(float *lo, float *hi, __m256 v) {
+            store<Stream>(lo, _mm256_castps256_ps128(v));
+            store<Stream>(hi, _mm256_extractf128_ps(v, 1));
+        }
+#endif
+
+        /**
+         * Vectors converted per SIMD step for this dimension and type (0: no SIMD path), and
+         * the alignment in bytes the streaming stores of a step need in SoA and AoS output.
+         */
+        template<unsigned int Dim, typename T>
+        struct TransposeTraits {
+            static constexpr std::size_t width = 0;
+            static constexpr std::size_t soa_alignment = alignof(T);
+            static constexpr std::size_t aos_alignment = alignof(T);
+        };
+
+#if defined(GEOMETRY_TRANSPOSE_SSE2)
+        template<unsigned int Dim>
+            requires (Dim == 3 || Dim == 4)
+        struct TransposeTraits<Dim, float> {
+#if defined(__AVX__)
+            static constexpr std::size_t width = 8;
+            static constexpr std::size_t soa_alignment = 32;
+            // Written one 128-bit lane at a time.
+            static constexpr std::size_t aos_alignment = 16;
+#else
+            static constexpr std::size_t width = 4;
+            static constexpr std::size_t soa_alignment = 16;
+            static constexpr std::size_t aos_alignment = 16;
+#endif
+        };
+
+        template<unsigned int Dim>
+            requires (Dim == 3 || Dim == 4)
+        struct TransposeTraits<Dim, double> {
+#if defined(__AVX__)
+            static constexpr std::size_t width = 4;
+            static constexpr std::size_t soa_alignment = 32;
+            static constexpr std::size_t aos_alignment = 32;
+#else
+            static constexpr std::size_t width = 2;
+            static constexpr std::size_t soa_alignment = 16;
+            static constexpr std::size_t aos_alignment = 16;
+#endif
+        };
+
+        /// Split `width` AoS vectors at `src` into the component arrays at `dst[c] + k`.
+        template<bool Stream, unsigned int Dim, typename T>
+        inline void block_to_soa(const T *src, const std::array<T *, Dim> &dst, std::size_t k) {
+            if constexpr (std::is_same_v<T, float> && Dim == 3) {
+#if defined(__AVX__)
+                // Vectors 0-3 in the low lanes, 4-7 in the high lanes, then the SSE shuffles per lane.
+                const auto a0 = load_lanes(src, src + 12);
+                const auto a1 = load_lanes(src + 4, src + 16);
+                const auto a2 = load_lanes(src + 8, src + 20);
+                const auto t0 = _mm256_shuffle_ps(a1, a2, _MM_SHUFFLE(2, 1, 3, 2));
+                const auto t1 = _mm256_shuffle_ps(a0, a1, _MM_SHUFFLE(1, 0, 2, 1));
+                store<Stream>(dst[0] + k, _mm256_shuffle_ps(a0, t0, _MM_SHUFFLE(2, 0, 3, 0)));
+                store<Stream>(dst[1] + k, _mm256_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0)));
+                store<Stream>(dst[2] + k, _mm256_shuffle_ps(t1, a2, _MM_SHUFFLE(3, 0, 3, 1)));
+#else
+                // a0 = x0 y0 z0 x1, a1 = y1 z1 x2 y2, a2 = z2 x3 y3 z3.
+                const auto a0 = _mm_loadu_ps(src), a1 = _mm_loadu_ps(src + 4), a2 = _mm_loadu_ps(src + 8);
+                const auto t0 = _mm_shuffle_ps(a1, a2, _MM_SHUFFLE(2, 1, 3, 2)); // x2 y2 x3 y3
+                const auto t1 = _mm_shuffle_ps(a0, a1, _MM_SHUFFLE(1, 0, 2, 1)); // y0 z0 y1 z1
+                store<Stream>(dst[0] + k, _mm_shuffle_ps(a0, t0, _MM_SHUFFLE(2, 0, 3, 0)));
+                store<Stream>(dst[1] + k, _mm_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0)));
+                store<Stream>(dst[2] + k, _mm_shuffle_ps(t1, a2, _MM_SHUFFLE(3, 0, 3, 1)));
+#endif
+            } else if constexpr (std::is_same_v<T, float> && Dim == 4) {
+#if defined(__AVX__)
+                // Row i holds vector i in the low lane and vector i + 4 in the high lane.
+                auto r0 = load_lanes(src, src + 16), r1 = load_lanes(src + 4, src + 20);
+                auto r2 = load_lanes(src + 8, src + 24), r3 = load_lanes(src + 12, src + 28);
+                const auto t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpackhi_ps(r0, r1);
+                const auto t2 = _mm256_unpacklo_ps(r2, r3), t3 = _mm256_unpackhi_ps(r2, r3);
+                store<Stream>(dst[0] + k, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+                store<Stream>(dst[1] + k, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+                store<Stream>(dst[2] + k, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+                store<Stream>(dst[3] + k, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+#else
+                auto r0 = _mm_loadu_ps(src), r1 = _mm_loadu_ps(src + 4);
+                auto r2 = _mm_loadu_ps(src + 8), r3 = _mm_loadu_ps(src + 12);
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                store<Stream>(dst[0] + k, r0);
+                store<Stream>(dst[1] + k, r1);
+                store<Stream>(dst[2] + k, r2);
+                store<Stream>(dst[3] + k, r3);
+#endif
+            } else if constexpr (std::is_same_v<T, double> && Dim == 3) {
+#if defined(__AVX__)
+                // a0 = x0 y0 z0 x1, a1 = y1 z1 x2 y2, a2 = z2 x3 y3 z3; regroup the 128-bit halves first.
+                const auto a0 = _mm256_loadu_pd(src), a1 = _mm256_loadu_pd(src + 4), a2 = _mm256_loadu_pd(src + 8);
+                const auto u0 = _mm256_permute2f128_pd(a0, a1, 0x30); // x0 y0 x2 y2
+                const auto u1 = _mm256_permute2f128_pd(a0, a2, 0x21); // z0 x1 z2 x3
+                const auto u2 = _mm256_permute2f128_pd(a1, a2, 0x30); // y1 z1 y3 z3
+                store<Stream>(dst[0] + k, _mm256_shuffle_pd(u0, u1, 0b1010));
+                store<Stream>(dst[1] + k, _mm256_shuffle_pd(u0, u2, 0b0101));
+                store<Stream>(dst[2] + k, _mm256_shuffle_pd(u1, u2, 0b1010));
+#else
+                // a0 = x0 y0, a1 = z0 x1, a2 = y1 z1.
+                const auto a0 = _mm_loadu_pd(src), a1 = _mm_loadu_pd(src + 2), a2 = _mm_loadu_pd(src + 4);
+                store<Stream>(dst[0] + k, _mm_shuffle_pd(a0, a1, 0b10));
+                store<Stream>(dst[1] + k, _mm_shuffle_pd(a0, a2, 0b01));
+                store<Stream>(dst[2] + k, _mm_shuffle_pd(a1, a2, 0b10));
+#endif
+            } else if constexpr (std::is_same_v<T, double> && Dim == 4) {
+#if defined(__AVX__)
+                const auto r0 = _mm256_loadu_pd(src), r1 = _mm256_loadu_pd(src + 4);
+                const auto r2 = _mm256_loadu_pd(src + 8), r3 = _mm256_loadu_pd(src + 12);
+                const auto t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1); // x0 x1 z0 z1, y0 y1 w0 w1
+                const auto t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+                store<Stream>(dst[0] + k, _mm256_permute2f128_pd(t0, t2, 0x20));
+                store<Stream>(dst[1] + k, _mm256_permute2f128_pd(t1, t3, 0x20));
+                store<Stream>(dst[2] + k, _mm256_permute2f128_pd(t0, t2, 0x31));
+                store<Stream>(dst[3] + k, _mm256_permute2f128_pd(t1, t3, 0x31));
+#else
+                const auto a0 = _mm_loadu_pd(src), b0 = _mm_loadu_pd(src + 2);
+                const auto a1 = _mm_loadu_pd(src + 4), b1 = _mm_loadu_pd(src + 6);
+                store<Stream>(dst[0] + k, _mm_unpacklo_pd(a0, a1));
+                store<Stream>(dst[1] + k, _mm_unpackhi_pd(a0, a1));
+                store<Stream>(dst[2] + k, _mm_unpacklo_pd(b0, b1));
+                store<Stream>(dst[3] + k, _mm_unpackhi_pd(b0, b1));
+#endif
+            }
+        }
+
+        /// Interleave `width` vectors from the component arrays at `src[c] + k` into `dst`.
+        template<bool Stream, unsigned int Dim, typename T>
+        inline void block_to_aos(const std::array<const T *, Dim> &src, std::size_t k, T *dst) {
+            if constexpr (std::is_same_v<T, float> && Dim == 3) {
+#if defined(__AVX__)
+                const auto x = _mm256_loadu_ps(src[0] + k), y = _mm256_loadu_ps(src[1] + k);
+                const auto z = _mm256_loadu_ps(src[2] + k);
+                const auto xy_lo = _mm256_unpacklo_ps(x, y), xy_hi = _mm256_unpackhi_ps(x, y);
+                const auto a0 = _mm256_shuffle_ps(xy_lo, _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                                                  _MM_SHUFFLE(2, 0, 1, 0));
+                const auto a1 = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy_hi,
+                                                  _MM_SHUFFLE(1, 0, 2, 0));
+                const auto t2 = _mm256_shuffle_ps(z, xy_hi, _MM_SHUFFLE(3, 2, 3, 2));
+                const auto a2 = _mm256_shuffle_ps(t2, t2, _MM_SHUFFLE(1, 3, 2, 0));
+                store_lanes<Stream>(dst, dst + 12, a0);
+                store_lanes<Stream>(dst + 4, dst + 16, a1);
+                store_lanes<Stream>(dst + 8, dst + 20, a2);
+#else
+                const auto x = _mm_loadu_ps(src[0] + k), y = _mm_loadu_ps(src[1] + k), z = _mm_loadu_ps(src[2] + k);
+                const auto xy_lo = _mm_unpacklo_ps(x, y), xy_hi = _mm_unpackhi_ps(x, y); // x0 y0 x1 y1, x2 y2 x3 y3
+                // x0 y0 z0 x1
+                store<Stream>(dst, _mm_shuffle_ps(xy_lo, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                                                  _MM_SHUFFLE(2, 0, 1, 0)));
+                // y1 z1 x2 y2
+                store<Stream>(dst + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy_hi,
+                                                      _MM_SHUFFLE(1, 0, 2, 0)));
+                // z2 x3 y3 z3
+                const auto t2 = _mm_shuffle_ps(z, xy_hi, _MM_SHUFFLE(3, 2, 3, 2));
+                store<Stream>(dst + 8, _mm_shuffle_ps(t2, t2, _MM_SHUFFLE(1, 3, 2, 0)));
+#endif
+            } else if constexpr (std::is_same_v<T, float> && Dim == 4) {
+#if defined(__AVX__)
+                const auto x = _mm256_loadu_ps(src[0] + k), y = _mm256_loadu_ps(src[1] + k);
+                const auto z = _mm256_loadu_ps(src[2] + k), w = _mm256_loadu_ps(src[3] + k);
+                const auto t0 = _mm256_unpacklo_ps(x, y), t1 = _mm256_unpackhi_ps(x, y);
+                const auto t2 = _mm256_unpacklo_ps(z, w), t3 = _mm256_unpackhi_ps(z, w);
+                // Vector i in the low lane, vector i + 4 in the high lane.
+                store_lanes<Stream>(dst, dst + 16, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+                store_lanes<Stream>(dst + 4, dst + 20, _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+                store_lanes<Stream>(dst + 8, dst + 24, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+                store_lanes<Stream>(dst + 12, dst + 28, _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+#else
+                auto x = _mm_loadu_ps(src[0] + k), y = _mm_loadu_ps(src[1] + k);
+                auto z = _mm_loadu_ps(src[2] + k), w = _mm_loadu_ps(src[3] + k);
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+                store<Stream>(dst, x);
+                store<Stream>(dst + 4, y);
+                store<Stream>(dst + 8, z);
+                store<Stream>(dst + 12, w);
+#endif
+            } else if constexpr (std::is_same_v<T, double> && Dim == 3) {
+#if defined(__AVX__)
+                const auto x = _mm256_loadu_pd(src[0] + k), y = _mm256_loadu_pd(src[1] + k);
+                const auto z = _mm256_loadu_pd(src[2] + k);
+                const auto u0 = _mm256_shuffle_pd(x, y, 0b0000); // x0 y0 x2 y2
+                const auto u1 = _mm256_shuffle_pd(z, x, 0b1010); // z0 x1 z2 x3
+                const auto u2 = _mm256_shuffle_pd(y, z, 0b1111); // y1 z1 y3 z3
+                store<Stream>(dst, _mm256_permute2f128_pd(u0, u1, 0x20));
+                store<Stream>(dst + 4, _mm256_permute2f128_pd(u2, u0, 0x30));
+                store<Stream>(dst + 8, _mm256_permute2f128_pd(u1, u2, 0x31));
+#else
+                const auto x = _mm_loadu_pd(src[0] + k), y = _mm_loadu_pd(src[1] + k), z = _mm_loadu_pd(src[2] + k);
+                store<Stream>(dst, _mm_shuffle_pd(x, y, 0b00));
+                store<Stream>(dst + 2, _mm_shuffle_pd(z, x, 0b10));
+                store<Stream>(dst + 4, _mm_shuffle_pd(y, z, 0b11));
+#endif
+            } else if constexpr (std::is_same_v<T, double> && Dim == 4) {
+#if defined(__AVX__)
+                const auto x = _mm256_loadu_pd(src[0] + k), y = _mm256_loadu_pd(src[1] + k);
+                const auto z = _mm256_loadu_pd(src[2] + k), w = _mm256_loadu_pd(src[3] + k);
+                const auto t0 = _mm256_unpacklo_pd(x, y), t1 = _mm256_unpackhi_pd(x, y); // x0 y0 x2 y2, x1 y1 x3 y3
+                const auto t2 = _mm256_unpacklo_pd(z, w), t3 = _mm256_unpackhi_pd(z, w);
+                store<Stream>(dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+                store<Stream>(dst + 4, _mm256_permute2f128_pd(t1, t3, 0x20));
+                store<Stream>(dst + 8, _mm256_permute2f128_pd(t0, t2, 0x31));
+                store<Stream>(dst + 12, _mm256_permute2f128_pd(t1, t3, 0x31));
+#else
+                const auto x = _mm_loadu_pd(src[0] + k), y = _mm_loadu_pd(src[1] + k);
+                const auto z = _mm_loadu_pd(src[2] + k), w = _mm_loadu_pd(src[3] + k);
+                store<Stream>(dst, _mm_unpacklo_pd(x, y));
+                store<Stream>(dst + 2, _mm_unpacklo_pd(z, w));
+                store<Stream>(dst + 4, _mm_unpackhi_pd(x, y));
+                store<Stream>(dst + 6, _mm_unpackhi_pd(z, w));
+#endif
+            }
+        }
+#endif
+
+        [[nodiscard]] inline bool is_aligned(const void *p, std::size_t alignment) {
+            return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+        }
+
+        /// Order streaming stores before any later store, as other threads may read the output.
+        inline void store_fence() {
+#if defined(GEOMETRY_TRANSPOSE_SSE2)
+            _mm_sfence();
+#endif
+        }
+    } // namespace detail
+
+    /**
+     * @brief Split AoS vectors into SoA components: out.component(c)[i] = in[i][c].
+     * @tparam Policy `StorePolicy::NonTemporal` for outputs that do not fit in cache.
+     */
+    template<StorePolicy Policy = StorePolicy::Cached, unsigned int Dim, typename T>
+    void aos_to_soa(std::span<const Vector<Dim, T>> in, SoASpan<Dim, T> out) {
+        static_assert(sizeof(Vector<Dim, T>) == Dim * sizeof(T), "Vector must be tightly packed.");
+        assert(out.size() >= in.size() && "Output span is too small.");
+        const auto n = in.size();
+        const auto *src = reinterpret_cast<const T *>(in.data());
+        std::array<T *, Dim> dst;
+        for (auto c = 0u; c < Dim; ++c) {
+            dst[c] = out.component(c).data();
+        }
+        const auto convert_one = [&](std::size_t i) {
+            for (auto c = 0u; c < Dim; ++c) {
+                dst[c][i] = src[i * Dim + c];
+            }
+        };
+        std::size_t k = 0;
+
+#if defined(GEOMETRY_TRANSPOSE_SSE2)
+        using Traits = detail::TransposeTraits<Dim, T>;
+        if constexpr (Traits::width > 0) {
+            const auto aligned = [&] {
+                for (auto c = 0u; c < Dim; ++c) {
+                    if (!detail::is_aligned(dst[c] + k, Traits::soa_alignment)) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+            if constexpr (Policy == StorePolicy::NonTemporal) {
+                for (; k < n && k < Traits::width && !aligned(); ++k) {
+                    convert_one(k);
+                }
+            }
+            if (Policy == StorePolicy::NonTemporal && aligned()) {
+                for (; k + Traits::width <= n; k += Traits::width) {
+                    detail::block_to_soa<true, Dim, T>(src + k * Dim, dst, k);
+                }
+                detail::store_fence();
+            } else {
+                for (; k + Traits::width <= n; k += Traits::width) {
+                    detail::block_to_soa<false, Dim, T>(src + k * Dim, dst, k);
+                }
+            }
+        }
+#endif
+        for (; k < n; ++k) {
+            convert_one(k);
+        }
+    }
+
+    /**
+     * @brief Interleave SoA components into AoS vectors: out[i][c] = in.component(c)[i].
+     * @tparam Policy `StorePolicy::NonTemporal` for outputs that do not fit in cache.
+     */
+    template<StorePolicy Policy = StorePolicy::Cached, unsigned int Dim, typename T>
+    void soa_to_aos(SoASpan<Dim, const T> in, std::span<Vector<Dim, T>> out) {
+        static_assert(sizeof(Vector<Dim, T>) == Dim * sizeof(T), "Vector must be tightly packed.");
+        assert(out.size() >= in.size() && "Output span is too small.");
+        const auto n = in.size();
+        std::array<const T *, Dim> src;
+        for (auto c = 0u; c < Dim; ++c) {
+            src[c] = in.component(c).data();
+        }
+        auto *dst = reinterpret_cast<T *>(out.data());
+        const auto convert_one = [&](std::size_t i) {
+            for (auto c = 0u; c < Dim; ++c) {
+                dst[i * Dim + c] = src[c][i];
+            }
+        };
+        std::size_t k = 0;
+
+#if defined(GEOMETRY_TRANSPOSE_SSE2)
+        using Traits = detail::TransposeTraits<Dim, T>;
+        if constexpr (Traits::width > 0) {
+            constexpr auto alignment = Traits::aos_alignment;
+            if constexpr (Policy == StorePolicy::NonTemporal) {
+                for (; k < n && k < Traits::width && !detail::is_aligned(dst + k * Dim, alignment); ++k) {
+                    convert_one(k);
+                }
+            }
+            if (Policy == StorePolicy::NonTemporal && detail::is_aligned(dst + k * Dim, alignment)) {
+                for (; k + Traits::width <= n; k += Traits::width) {
+                    detail::block_to_aos<true, Dim, T>(src, k, dst + k * Dim);
+                }
+                detail::store_fence();
+            } else {
+                for (; k + Traits::width <= n; k += Traits::width) {
+                    detail::block_to_aos<false, Dim, T>(src, k, dst + k * Dim);
+                }
+            }
+        }
+#endif
+        for (; k < n; ++k) {
+            convert_one(k);
+        }
+    }
+} // namespace Geometry
+
+#endif // TRANSPOSE_H
@@ -4,7 +4,12 @@
  *
  * This header defines a templated N-dimensional vector class for arithmetic types,
  * supporting mathematical operations such as addition, subtraction, scalar and
- * component-wise multiplication, normalization, dot and cross products.
+ * component-wise multiplication and division, normalization, dot and cross products,
+ * 2D perp-dot, perpendicular and rotation,
+ * plus free component-wise functions (min, max, abs, clamp, floor, lerp, comparison
+ * masks and select) and geometric ones (angle_between, slerp, reflect, refract).
+ * `UnitVector` marks vectors known to be normalized, so projections and reflections
+ * skip their divisions and `normalize()` becomes a no-op (`bench lighting` measures it).
  * Requires C++20
  * @author Gael
  * @date 27/09/2025
@@ -21,8 +26,13 @@
 #include <cmath>
 #include <cassert>
 #include <stdexcept>
+#include <limits>
 
 namespace Geometry {
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    class UnitVector;
+
     /**
      * @class Vector
      * @brief A generic N-dimensional mathematical vector class.
@@ -181,6 +191,32 @@ namespace Geometry {
             return v * scalar;
         }
 
+        /**
+         * @brief Component-wise division.
+         * @return Resulting vector: vec{c}_i = vec{a}_i / vec{b}_i
+         */
+        template<unsigned int Dim2, typename T2>
+        [[nodiscard]] constexpr auto operator/(const Vector<Dim2, T2> &other) const {
+            Vector<Dim, T> result;
+            static_assert(Dim == Dim2, "Cannot divide vectors of different dimensions.");
+            for (auto i = 0u; i < Dim; ++i) {
+                result[i] = _data[i] / other[i];
+            }
+            return result;
+        }
+
+        /**
+        * @brief Component-wise division by a scalar.
+        * @return Resulting vector: vec{v}_i = vec{v}_i / scalar
+        */
+        [[nodiscard]] constexpr Vector operator/(T scalar) const {
+            Vector result;
+            for (auto i = 0u; i < Dim; ++i) {
+                result[i] = _data[i] / scalar;
+            }
+            return result;
+        }
+
         /// @brief Equality operator (component-wise).
         constexpr bool operator==(const Vector &other) const {
             return _data == other._data;
@@ -242,7 +278,7 @@ namespace Geometry {
 
         /**
          * @brief Return a normalized copy of the vector.
-         * @return norm{v} = vec{v} / |vec{v}|
+         * @return norm{v} = vec{v} / |vec{v}|, as a `UnitVector` for floating-point types.
          */
         [[nodiscard("`normalized()` returns a new vector. Use `normalize()` for in-place operation.")]]
         auto normalized() const {
@@ -252,7 +288,11 @@ namespace Geometry {
             for (auto i = 0; i < Dim; ++i) {
                 normalized[i] = _data[i] / vect_mag;
             }
-            return normalized;
+            if constexpr (std::is_floating_point_v<T>) {
+                return UnitVector<Dim, T>(normalized, typename UnitVector<Dim, T>::Trusted{});
+            } else {
+                return normalized;
+            }
         }
 
         /**
@@ -285,6 +325,49 @@ namespace Geometry {
             );
         }
 
+        /**
+         * @brief 2D cross product (perp-dot): a_x b_y - a_y b_x, the z of the 3D cross product.
+         * @return Positive if `other` is counter-clockwise from this vector, negative if clockwise.
+         * @note Only enabled for Dim == 2.
+         */
+        template<typename T2 = T>
+        [[nodiscard]] constexpr auto perp_dot(const Vector<Dim, T2> &other) const
+            requires (Dim == 2) {
+            return _data[0] * other[1] - _data[1] * other[0];
+        }
+
+        /**
+         * @brief The vector rotated by +90 degrees: (-y, x).
+         * @note Only enabled for Dim == 2.
+         */
+        [[nodiscard]] constexpr Vector perp() const
+            requires (Dim == 2) {
+            return Vector(-_data[1], _data[0]);
+        }
+
+        /**
+         * @brief Rotate by the unit complex number `rotation` = (cos a, sin a).
+         *
+         * Complex multiplication (c x - s y, s x + c y): 4 multiplies and no trigonometry, so
+         * rotating many vectors by the same angle pays for cos/sin once. Rotating one rotation
+         * by another composes them.
+         * @note Only enabled for Dim == 2.
+         */
+        [[nodiscard]] constexpr Vector rotated(const Vector &rotation) const
+            requires (Dim == 2) {
+            return Vector(rotation[0] * _data[0] - rotation[1] * _data[1],
+                          rotation[1] * _data[0] + rotation[0] * _data[1]);
+        }
+
+        /**
+         * @brief Rotate counter-clockwise by `angle` radians.
+         * @note Only enabled for floating-point Dim == 2.
+         */
+        [[nodiscard]] Vector rotated(T angle) const
+            requires (Dim == 2 && std::is_floating_point_v<T>) {
+            return rotated(Vector(std::cos(angle), std::sin(angle)));
+        }
+
         /**
          * @brief Computes the vector projection of this vector onto another vector.
          *
@@ -315,8 +398,359 @@ namespace Geometry {
             return project_on * scalar;
         }
 
+        /// @brief Projection onto a unit vector: (a · b) b, without the division by |b|^2.
+        template<typename T2 = T>
+        [[nodiscard]] auto project(const UnitVector<Dim, T2> &project_on) const {
+            return project_on * this->dot(project_on);
+        }
+
+    };
+
+    /**
+     * @class UnitVector
+     * @brief A Vector statically known to have unit length.
+     *
+     * Only produced by operations that keep the length at one: `Vector::normalized()`,
+     * quaternion rotation, reflection about a unit normal, or `from_unit()` for data
+     * normalized elsewhere. Component writes are hidden; arithmetic on a UnitVector
+     * returns a plain Vector.
+     *
+     * @tparam T The scalar type. Must be floating point.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    class UnitVector : public Vector<Dim, T> {
+        using Base = Vector<Dim, T>;
+        friend class Vector<Dim, T>;
+
+        /// Tag of the unchecked constructor used by `Vector::normalized()`.
+        struct Trusted {
+        };
+
+        constexpr UnitVector(const Base &unit, Trusted) : Base(unit) {
+        }
+
+    public:
+        /// @brief Default constructor gives the first axis.
+        constexpr UnitVector() {
+            Base::operator[](0) = T(1);
+        }
+
+        /// @brief Normalize `v` (must be non-zero).
+        explicit UnitVector(const Base &v) : UnitVector(v.normalized()) {
+        }
+
+        /**
+         * @brief Wrap a vector that is already unit length, without normalizing it.
+         * @note Checked in debug builds only, to a tolerance of sqrt(epsilon).
+         */
+        [[nodiscard]] static UnitVector from_unit(const Base &unit) {
+            assert(std::abs(unit.squared_mag() - T(1)) <= std::sqrt(std::numeric_limits<T>::epsilon())
+                && "Vector is not unit length.");
+            return UnitVector(unit, Trusted{});
+        }
+
+        /// @brief Read-only element access; hides the mutable overload.
+        constexpr const T &operator[](std::size_t index) const {
+            return Base::operator[](index);
+        }
+
+        /// @brief No-op: the vector is already normalized.
+        constexpr void normalize() {
+        }
+
+        /// @brief Returns a copy; the vector is already normalized.
+        [[nodiscard]] constexpr UnitVector normalized() const {
+            return *this;
+        }
     };
 
+    /// @brief Result of a component-wise comparison, consumed by `select`, `any` and `all`.
+    template<unsigned int Dim>
+    using VectorMask = Vector<Dim, bool>;
+
+    namespace detail {
+        /// Apply `fn` to every component of the argument vectors.
+        template<typename R, unsigned int Dim, typename Fn, typename... Vs>
+        constexpr Vector<Dim, R> componentwise(Fn &&fn, const Vs &... vs) {
+            Vector<Dim, R> result;
+            for (auto i = 0u; i < Dim; ++i) {
+                result[i] = static_cast<R>(fn(vs[i]...));
+            }
+            return result;
+        }
+    } // namespace detail
+
+    /**
+     * @name Component-wise functions
+     * Free functions applying a scalar function to each component. They compile to plain
+     * loops over the components, which the compiler turns into branch-free SIMD code
+     * (min/max/blend instructions) for float and double. Batched SoA forms live in VectorBatch.h.
+     * @{
+     */
+
+    /// @brief Component-wise minimum.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr Vector<Dim, T> min(const Vector<Dim, T> &a, const Vector<Dim, T> &b) {
+        return detail::componentwise<T, Dim>([](T x, T y) { return y < x ? y : x; }, a, b);
+    }
+
+    /// @brief Component-wise maximum.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr Vector<Dim, T> max(const Vector<Dim, T> &a, const Vector<Dim, T> &b) {
+        return detail::componentwise<T, Dim>([](T x, T y) { return x < y ? y : x; }, a, b);
+    }
+
+    /// @brief Component-wise absolute value.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr Vector<Dim, T> abs(const Vector<Dim, T> &v) {
+        return detail::componentwise<T, Dim>([](T x) {
+            if constexpr (std::is_unsigned_v<T>) {
+                return x;
+            } else {
+                return x < 0 ? -x : x;
+            }
+        }, v);
+    }
+
+    /// @brief Clamp every component to [lo_i, hi_i].
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr Vector<Dim, T> clamp(const Vector<Dim, T> &v, const Vector<Dim, T> &lo,
+                                                 const Vector<Dim, T> &hi) {
+        return min(max(v, lo), hi);
+    }
+
+    /// @brief Clamp every component to [lo, hi].
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr Vector<Dim, T> clamp(const Vector<Dim, T> &v, T lo, T hi) {
+        return clamp(v, Vector<Dim, T>(lo), Vector<Dim, T>(hi));
+    }
+
+    /// @brief Component-wise floor (identity for integral types).
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] Vector<Dim, T> floor(const Vector<Dim, T> &v) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return detail::componentwise<T, Dim>([](T x) { return std::floor(x); }, v);
+        } else {
+            return v;
+        }
+    }
+
+    /// @brief Component-wise ceiling (identity for integral types).
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] Vector<Dim, T> ceil(const Vector<Dim, T> &v) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return detail::componentwise<T, Dim>([](T x) { return std::ceil(x); }, v);
+        } else {
+            return v;
+        }
+    }
+
+    /// @brief Component-wise rounding to nearest, halfway cases away from zero (identity for integral types).
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] Vector<Dim, T> round(const Vector<Dim, T> &v) {
+        if constexpr (std::is_floating_point_v<T>) {
+            return detail::componentwise<T, Dim>([](T x) { return std::round(x); }, v);
+        } else {
+            return v;
+        }
+    }
+
+    /**
+     * @brief Linear interpolation a + (b - a) * t.
+     * @note Exact at t = 0; at t = 1 it may differ from b by one rounding.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] constexpr Vector<Dim, T> lerp(const Vector<Dim, T> &a, const Vector<Dim, T> &b, T t) {
+        return detail::componentwise<T, Dim>([t](T x, T y) { return x + (y - x) * t; }, a, b);
+    }
+
+    /// @brief Mask of a_i < b_i.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr VectorMask<Dim> less(const Vector<Dim, T> &a, const Vector<Dim, T> &b) {
+        return detail::componentwise<bool, Dim>([](T x, T y) { return x < y; }, a, b);
+    }
+
+    /// @brief Mask of a_i <= b_i.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr VectorMask<Dim> less_equal(const Vector<Dim, T> &a, const Vector<Dim, T> &b) {
+        return detail::componentwise<bool, Dim>([](T x, T y) { return x <= y; }, a, b);
+    }
+
+    /// @brief Mask of a_i > b_i.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr VectorMask<Dim> greater(const Vector<Dim, T> &a, const Vector<Dim, T> &b) {
+        return detail::componentwise<bool, Dim>([](T x, T y) { return x > y; }, a, b);
+    }
+
+    /// @brief Mask of a_i >= b_i.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr VectorMask<Dim> greater_equal(const Vector<Dim, T> &a, const Vector<Dim, T> &b) {
+        return detail::componentwise<bool, Dim>([](T x, T y) { return x >= y; }, a, b);
+    }
+
+    /// @brief Mask of a_i == b_i.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr VectorMask<Dim> equal(const Vector<Dim, T> &a, const Vector<Dim, T> &b) {
+        return detail::componentwise<bool, Dim>([](T x, T y) { return x == y; }, a, b);
+    }
+
+    /// @brief Branch-free blend: mask_i ? a_i : b_i.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr Vector<Dim, T> select(const VectorMask<Dim> &mask, const Vector<Dim, T> &a,
+                                                  const Vector<Dim, T> &b) {
+        return detail::componentwise<T, Dim>([](bool m, T x, T y) { return m ? x : y; }, mask, a, b);
+    }
+
+    /// @brief True if any component of the mask is set.
+    template<unsigned int Dim>
+    [[nodiscard]] constexpr bool any(const VectorMask<Dim> &mask) {
+        bool result = false;
+        for (auto i = 0u; i < Dim; ++i) {
+            result |= mask[i];
+        }
+        return result;
+    }
+
+    /// @brief True if every component of the mask is set.
+    template<unsigned int Dim>
+    [[nodiscard]] constexpr bool all(const VectorMask<Dim> &mask) {
+        bool result = true;
+        for (auto i = 0u; i < Dim; ++i) {
+            result &= mask[i];
+        }
+        return result;
+    }
+
+    /// @brief Smallest component.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr T min_component(const Vector<Dim, T> &v) {
+        auto result = v[0];
+        for (auto i = 1u; i < Dim; ++i) {
+            result = v[i] < result ? v[i] : result;
+        }
+        return result;
+    }
+
+    /// @brief Largest component.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] constexpr T max_component(const Vector<Dim, T> &v) {
+        auto result = v[0];
+        for (auto i = 1u; i < Dim; ++i) {
+            result = result < v[i] ? v[i] : result;
+        }
+        return result;
+    }
+
+    /** @} */
+
+    namespace detail {
+        /// Angle between a and b from an atan2 implementation (std or vectorizable).
+        template<unsigned int Dim, typename T, typename Atan2>
+        T angle_between(const Vector<Dim, T> &a, const Vector<Dim, T> &b, Atan2 &&atan2) {
+            if constexpr (Dim == 3) {
+                return atan2(a.cross(b).magnitude(), a.dot(b));
+            } else if constexpr (Dim == 2) {
+                const auto perp_dot = a.perp_dot(b);
+                return atan2(perp_dot < 0 ? -perp_dot : perp_dot, a.dot(b));
+            } else {
+                // Kahan: the angle between a |b| and b |a| from the diagonals of their rhombus.
+                const auto u = a * b.magnitude(), v = b * a.magnitude();
+                return T(2) * atan2((u - v).magnitude(), (u + v).magnitude());
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @name Geometric functions
+     * Angles, interpolation on the sphere and reflection / refraction. Batched SoA forms live
+     * in VectorBatch.h.
+     * @{
+     */
+
+    /**
+     * @brief Angle between two non-zero vectors, in [0, pi].
+     *
+     * atan2(|a x b|, a . b) keeps full precision for nearly parallel and nearly opposite
+     * vectors, where acos of the normalized dot product loses half of its digits. Other
+     * dimensions than 2 and 3 use Kahan's formula 2 atan2(|a |b| - b |a||, |a |b| + b |a||).
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] T angle_between(const Vector<Dim, T> &a, const Vector<Dim, T> &b) {
+        return detail::angle_between(a, b, [](T y, T x) { return std::atan2(y, x); });
+    }
+
+    /**
+     * @brief Orientation of the 2D triangle (a, b, c): the sign of (b - a) perp-dot (c - a).
+     * @return 1 if counter-clockwise, -1 if clockwise, 0 if collinear.
+     * @note Exact for integer coordinates; nearly collinear floating-point inputs may get
+     *       the wrong sign from rounding.
+     */
+    template<typename T>
+    [[nodiscard]] constexpr int orientation(const Vector<2, T> &a, const Vector<2, T> &b, const Vector<2, T> &c) {
+        const auto d = (b - a).perp_dot(c - a);
+        return (d > 0) - (d < 0);
+    }
+
+    /**
+     * @brief Spherical linear interpolation between unit vectors, constant angular speed in t.
+     * @note Nearly parallel inputs fall back to a normalized lerp; opposite inputs have no
+     *       unique great circle and give an arbitrary result.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] Vector<Dim, T> slerp(const Vector<Dim, T> &a, const Vector<Dim, T> &b, T t) {
+        const auto theta = angle_between(a, b);
+        if (theta < std::sqrt(std::numeric_limits<T>::epsilon())) {
+            return lerp(a, b, t).normalized();
+        }
+        const auto s = std::sin(theta);
+        return a * (std::sin((T(1) - t) * theta) / s) + b * (std::sin(t * theta) / s);
+    }
+
+    /// @brief Mirror v about the plane of normal n (any non-zero length): v - 2 (v . n) / (n . n) n.
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] Vector<Dim, T> reflect(const Vector<Dim, T> &v, const Vector<Dim, T> &n) {
+        const auto n2 = n.squared_mag();
+        assert(n2 > 0 && "Cannot reflect about a zero normal.");
+        return v - n * (T(2) * v.dot(n) / n2);
+    }
+
+    /// @brief Mirror v about the plane of unit normal n: v - 2 (v . n) n.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] Vector<Dim, T> reflect(const Vector<Dim, T> &v, const UnitVector<Dim, T> &n) {
+        return v - n * (T(2) * v.dot(n));
+    }
+
+    /// @brief Reflection keeps the length, so a unit direction stays a UnitVector.
+    template<unsigned int Dim, typename T>
+    [[nodiscard]] UnitVector<Dim, T> reflect(const UnitVector<Dim, T> &v, const UnitVector<Dim, T> &n) {
+        return UnitVector<Dim, T>::from_unit(v - n * (T(2) * v.dot(n)));
+    }
+
+    /**
+     * @brief Refract the unit direction i through a surface of unit normal n (Snell's law).
+     *
+     * Same convention as GLSL `refract`: n faces against i and eta is the ratio of the
+     * refractive indices, incident over transmitted.
+     * @return The unit transmitted direction, or the zero vector on total internal reflection.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    [[nodiscard]] Vector<Dim, T> refract(const Vector<Dim, T> &i, const Vector<Dim, T> &n, T eta) {
+        const auto cos_i = n.dot(i);
+        const auto k = T(1) - eta * eta * (T(1) - cos_i * cos_i);
+        if (k < 0) {
+            return Vector<Dim, T>();
+        }
+        return i * eta - n * (eta * cos_i + std::sqrt(k));
+    }
+
+    /** @} */
+
     // Typedefs for common use cases.
     using Vector2 = Vector<2, double>;
     using Vector3 = Vector<3, double>;
@@ -324,6 +758,10 @@ namespace Geometry {
     using Vector3f = Vector<3, float>;
     using Vector2i = Vector<2, int>;
     using Vector3i = Vector<3, int>;
+    using UnitVector2 = UnitVector<2, double>;
+    using UnitVector3 = UnitVector<3, double>;
+    using UnitVector2f = UnitVector<2, float>;
+    using UnitVector3f = UnitVector<3, float>;
 } // namespace Geometry
 
 #endif // VECTOR_H
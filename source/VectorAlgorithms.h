@@ -0,0 +1,177 @@
+/**
+ * @file VectorAlgorithms.h
+ * @brief Batched algorithms over spans of `Vector`, with execution-policy overloads.
+ *
+ * `transform`, `reduce`, `normalize` and `sort_by_key` take an optional execution policy as
+ * first argument, like the standard algorithms:
+ * @code
+ * normalize(execution::par, std::span<const Vector3f>(in), std::span<Vector3f>(out));
+ * const auto total = reduce(execution::par_unseq, std::span<const Vector3f>(in));
+ * @endcode
+ * The `std::execution` policies work too once StdExecution.h is included. Without a policy
+ * the algorithms run on the calling thread. A parallel policy splits the span with
+ * `parallel_for` into as many pieces as keep each thread above `min_thread_work_ns` of work,
+ * using the per-element cost estimates of `element_cost_ns` (Parallel.h): a 10K-element
+ * normalize (40 us) stays on the calling thread, a million-element one is split across up to
+ * 40 threads. `transform` cannot know the cost of its function and assumes a cheap one
+ * (1 ns); set `ParallelPolicy::grain` for expensive functions.
+ *
+ * Results do not depend on the policy or thread count: `reduce` folds fixed blocks and
+ * combines them in order, and `sort_by_key` breaks ties by position.
+ * Requires C++20
+ */
+
+#ifndef VECTORALGORITHMS_H
+#define VECTORALGORITHMS_H
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "FastMath.h"
+#include "Parallel.h"
+#include "Vector.h"
+
+namespace Geometry {
+    namespace detail {
+        /// Elements folded into each partial result of `reduce`, whatever the thread count.
+        inline constexpr std::size_t reduce_block_size = 1024;
+    } // namespace detail
+
+    /// @brief out[i] = fn(in[i]); `out` may alias `in`.
+    template<ExecutionPolicy Policy, unsigned int Dim, typename T, typename Out, typename Fn>
+    void transform(const Policy &policy, std::span<const Vector<Dim, T>> in, std::span<Out> out, Fn &&fn) {
+        assert(out.size() >= in.size() && "Output span is too small.");
+        parallel_for(policy, in.size(), element_cost_ns::transform,
+                     [&](std::size_t begin, std::size_t end, unsigned int) {
+                         for (auto i = begin; i < end; ++i) {
+                             out[i] = fn(in[i]);
+                         }
+                     });
+    }
+
+    template<unsigned int Dim, typename T, typename Out, typename Fn>
+    void transform(std::span<const Vector<Dim, T>> in, std::span<Out> out, Fn &&fn) {
+        transform(execution::seq, in, out, std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief init op in[0] op in[1] op ..., for an associative `op`.
+     *
+     * Blocks of `detail::reduce_block_size` elements are folded separately, then combined in
+     * order, so the rounding is the same for every policy.
+     */
+    template<ExecutionPolicy Policy, unsigned int Dim, typename T, typename Op = std::plus<>>
+    [[nodiscard]] Vector<Dim, T> reduce(const Policy &policy, std::span<const Vector<Dim, T>> in,
+                                        Vector<Dim, T> init = Vector<Dim, T>(), Op op = Op()) {
+        constexpr auto block = detail::reduce_block_size;
+        std::vector<Vector<Dim, T>> partial((in.size() + block - 1) / block);
+        parallel_for(policy, partial.size(), element_cost_ns::reduce * block,
+                     [&](std::size_t begin, std::size_t end, unsigned int) {
+                         for (auto b = begin; b < end; ++b) {
+                             const auto last = std::min(in.size(), (b + 1) * block);
+                             auto sum = in[b * block];
+                             for (auto i = b * block + 1; i < last; ++i) {
+                                 sum = op(sum, in[i]);
+                             }
+                             partial[b] = sum;
+                         }
+                     });
+        for (const auto &sum: partial) {
+            init = op(init, sum);
+        }
+        return init;
+    }
+
+    template<unsigned int Dim, typename T, typename Op = std::plus<>>
+    [[nodiscard]] Vector<Dim, T> reduce(std::span<const Vector<Dim, T>> in, Vector<Dim, T> init = Vector<Dim, T>(),
+                                        Op op = Op()) {
+        return reduce(execution::seq, in, init, op);
+    }
+
+    /// @brief out[i] = in[i] / |in[i]|; zero vectors stay zero. `out` may alias `in`.
+    template<ExecutionPolicy Policy, unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void normalize(const Policy &policy, std::span<const std::type_identity_t<Vector<Dim, T>>> in,
+                   std::span<Vector<Dim, T>> out) {
+        assert(out.size() >= in.size() && "Output span is too small.");
+        parallel_for(policy, in.size(), element_cost_ns::normalize,
+                     [&](std::size_t begin, std::size_t end, unsigned int) {
+                         for (auto i = begin; i < end; ++i) {
+                             const auto v = in[i];
+                             const auto squared = v.squared_mag();
+                             out[i] = v * fastmath::blend(squared > 0, T(1) / std::sqrt(squared), T(0));
+                         }
+                     });
+    }
+
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void normalize(std::span<const std::type_identity_t<Vector<Dim, T>>> in, std::span<Vector<Dim, T>> out) {
+        normalize(execution::seq, in, out);
+    }
+
+    /**
+     * @brief Sort `values` by ascending `key(value)`; equal keys keep their order.
+     *
+     * Keys are computed once per element. Pieces are sorted on separate threads, then merged
+     * pairwise, also in parallel, before the vectors are moved to their place.
+     */
+    template<ExecutionPolicy Policy, unsigned int Dim, typename T, typename KeyFn>
+    void sort_by_key(const Policy &policy, std::span<Vector<Dim, T>> values, KeyFn &&key) {
+        using Key = std::remove_cvref_t<std::invoke_result_t<KeyFn &, const Vector<Dim, T> &>>;
+        const auto n = values.size();
+        std::vector<std::pair<Key, std::size_t>> order(n);
+        parallel_for(policy, n, element_cost_ns::transform, [&](std::size_t begin, std::size_t end, unsigned int) {
+            for (auto i = begin; i < end; ++i) {
+                order[i] = {key(values[i]), i};
+            }
+        });
+
+        // (key, position) pairs are all distinct, so any merge order gives the stable result.
+        const auto levels = static_cast<double>(std::max<std::size_t>(std::bit_width(n), 1));
+        const std::size_t pieces = policy_thread_count(policy, n, element_cost_ns::sort * levels);
+        std::vector<std::size_t> bounds(pieces + 1, n);
+        for (std::size_t p = 0; p < pieces; ++p) {
+            bounds[p] = chunk_range(n, p, pieces).first;
+        }
+        parallel_for(pieces, [&](std::size_t begin, std::size_t end, unsigned int) {
+            for (auto p = begin; p < end; ++p) {
+                std::sort(order.begin() + bounds[p], order.begin() + bounds[p + 1]);
+            }
+        }, static_cast<unsigned int>(pieces));
+        for (std::size_t width = 1; width < pieces; width *= 2) {
+            const auto merges = (pieces + 2 * width - 1) / (2 * width);
+            parallel_for(merges, [&](std::size_t begin, std::size_t end, unsigned int) {
+                for (auto m = begin; m < end; ++m) {
+                    const auto first = m * 2 * width;
+                    const auto middle = std::min(first + width, pieces), last = std::min(first + 2 * width, pieces);
+                    std::inplace_merge(order.begin() + bounds[first], order.begin() + bounds[middle],
+                                       order.begin() + bounds[last]);
+                }
+            }, static_cast<unsigned int>(merges));
+        }
+
+        std::vector<Vector<Dim, T>> sorted(n);
+        parallel_for(policy, n, element_cost_ns::transform, [&](std::size_t begin, std::size_t end, unsigned int) {
+            for (auto i = begin; i < end; ++i) {
+                sorted[i] = values[order[i].second];
+            }
+        });
+        std::copy(sorted.begin(), sorted.end(), values.begin());
+    }
+
+    template<unsigned int Dim, typename T, typename KeyFn>
+    void sort_by_key(std::span<Vector<Dim, T>> values, KeyFn &&key) {
+        sort_by_key(execution::seq, values, std::forward<KeyFn>(key));
+    }
+} // namespace Geometry
+
+#endif // VECTORALGORITHMS_H
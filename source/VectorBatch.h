@@ -0,0 +1,453 @@
+/**
+ * @file VectorBatch.h
+ * @brief Batched component-wise vector functions over SoA arrays.
+ *
+ * SoA counterparts of the component-wise functions of Vector.h (arithmetic, min, max,
+ * abs, clamp, floor, lerp, comparisons, select) and of its geometric functions
+ * (angle_between, slerp, reflect, refract) and 2D functions (perp_dot, perp, rotate,
+ * orientation). Component-wise kernels run one tight loop
+ * per component, geometric ones load every component of an element per iteration; both
+ * are free of branches, so the compiler emits packed SIMD instructions for whatever
+ * instruction set it targets (SSE, AVX2, AVX-512, NEON). The geometric kernels call
+ * std::sqrt and vectorize only with -fno-math-errno.
+ *
+ * Inputs are read-only `SoASpan<Dim, const T>` views; `Dim` and `T` are deduced from the
+ * output, so mutable spans and `SoAArray::span()` can be passed directly. Comparisons
+ * write byte masks (0 or 1, `SoAArray<Dim, std::uint8_t>`), the batched counterpart of
+ * `VectorMask`, and take the scalar type explicitly: `less<float>(a, b, mask)`.
+ * Outputs may alias inputs element for element.
+ * Requires C++20
+ */
+
+#ifndef VECTORBATCH_H
+#define VECTORBATCH_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "FastMath.h"
+#include "SoA.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /// @brief Read-only SoA input whose type is taken from the output argument.
+    template<unsigned int Dim, typename T>
+    using SoAInput = std::type_identity_t<SoASpan<Dim, const T>>;
+
+    /// @brief Read-only SoA mask input.
+    template<unsigned int Dim>
+    using SoAMask = SoASpan<Dim, const std::uint8_t>;
+
+    namespace detail {
+        /// out.component(c)[i] = fn(in.component(c)[i]...) for every component and element of the first input.
+        template<unsigned int Dim, typename R, typename Fn, typename First, typename... Rest>
+        void soa_componentwise(SoASpan<Dim, R> out, Fn &&fn, const First &first, const Rest &... rest) {
+            const auto n = first.size();
+            assert(out.size() >= n && "Output span is too small.");
+            assert(((rest.size() >= n) && ...) && "Input spans have different sizes.");
+            for (auto c = 0u; c < Dim; ++c) {
+                const auto dst = out.component(c);
+                [&](const auto &... src) {
+                    for (std::size_t i = 0; i < n; ++i) {
+                        dst[i] = fn(src[i]...);
+                    }
+                }(first.component(c), rest.component(c)...);
+            }
+        }
+
+        /// SoA view repeating one array in every component (per-element scalar parameter).
+        template<unsigned int Dim, typename T>
+        SoASpan<Dim, const T> broadcast_components(std::span<const T> values) {
+            std::array<std::span<const T>, Dim> components;
+            components.fill(values);
+            return SoASpan<Dim, const T>(components);
+        }
+    } // namespace detail
+
+    /// @brief out = a + b.
+    template<unsigned int Dim, typename T>
+    void add(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x, T y) { return x + y; }, a, b);
+    }
+
+    /// @brief out = a - b.
+    template<unsigned int Dim, typename T>
+    void subtract(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x, T y) { return x - y; }, a, b);
+    }
+
+    /// @brief out = a * b (component-wise).
+    template<unsigned int Dim, typename T>
+    void multiply(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x, T y) { return x * y; }, a, b);
+    }
+
+    /// @brief out = a / b (component-wise).
+    template<unsigned int Dim, typename T>
+    void divide(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x, T y) { return x / y; }, a, b);
+    }
+
+    /// @brief out = a * scalar.
+    template<unsigned int Dim, typename T>
+    void scale(SoAInput<Dim, T> a, std::type_identity_t<T> scalar, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [scalar](T x) { return x * scalar; }, a);
+    }
+
+    /// @brief Component-wise minimum.
+    template<unsigned int Dim, typename T>
+    void min(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x, T y) { return y < x ? y : x; }, a, b);
+    }
+
+    /// @brief Component-wise maximum.
+    template<unsigned int Dim, typename T>
+    void max(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x, T y) { return x < y ? y : x; }, a, b);
+    }
+
+    /// @brief Component-wise absolute value.
+    template<unsigned int Dim, typename T>
+    void abs(SoAInput<Dim, T> v, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x) {
+            if constexpr (std::is_unsigned_v<T>) {
+                return x;
+            } else {
+                return x < 0 ? -x : x;
+            }
+        }, v);
+    }
+
+    /// @brief Clamp every component to [lo, hi] (per element bounds).
+    template<unsigned int Dim, typename T>
+    void clamp(SoAInput<Dim, T> v, SoAInput<Dim, T> lo, SoAInput<Dim, T> hi, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x, T l, T h) {
+            const auto low = x < l ? l : x;
+            return h < low ? h : low;
+        }, v, lo, hi);
+    }
+
+    /// @brief Clamp every component to [lo, hi].
+    template<unsigned int Dim, typename T>
+    void clamp(SoAInput<Dim, T> v, std::type_identity_t<T> lo, std::type_identity_t<T> hi, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [lo, hi](T x) {
+            const auto low = x < lo ? lo : x;
+            return hi < low ? hi : low;
+        }, v);
+    }
+
+    /// @brief Component-wise floor.
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void floor(SoAInput<Dim, T> v, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x) { return std::floor(x); }, v);
+    }
+
+    /// @brief Component-wise ceiling.
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void ceil(SoAInput<Dim, T> v, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x) { return std::ceil(x); }, v);
+    }
+
+    /// @brief Component-wise rounding to nearest, halfway cases away from zero.
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void round(SoAInput<Dim, T> v, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x) { return std::round(x); }, v);
+    }
+
+    /// @brief out = a + (b - a) * t with one t for every element.
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void lerp(SoAInput<Dim, T> a, SoAInput<Dim, T> b, std::type_identity_t<T> t, SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [t](T x, T y) { return x + (y - x) * t; }, a, b);
+    }
+
+    /// @brief out[i] = a[i] + (b[i] - a[i]) * t[i].
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void lerp(SoAInput<Dim, T> a, SoAInput<Dim, T> b, std::span<const std::type_identity_t<T>> t,
+              SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x, T y, T s) { return x + (y - x) * s; },
+                                  a, b, detail::broadcast_components<Dim, T>(t));
+    }
+
+    /// @brief mask = a < b.
+    template<typename T, unsigned int Dim>
+    void less(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, std::uint8_t> mask) {
+        detail::soa_componentwise(mask, [](T x, T y) { return x < y; }, a, b);
+    }
+
+    /// @brief mask = a <= b.
+    template<typename T, unsigned int Dim>
+    void less_equal(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, std::uint8_t> mask) {
+        detail::soa_componentwise(mask, [](T x, T y) { return x <= y; }, a, b);
+    }
+
+    /// @brief mask = a > b.
+    template<typename T, unsigned int Dim>
+    void greater(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, std::uint8_t> mask) {
+        detail::soa_componentwise(mask, [](T x, T y) { return x > y; }, a, b);
+    }
+
+    /// @brief mask = a >= b.
+    template<typename T, unsigned int Dim>
+    void greater_equal(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, std::uint8_t> mask) {
+        detail::soa_componentwise(mask, [](T x, T y) { return x >= y; }, a, b);
+    }
+
+    /// @brief mask = a == b.
+    template<typename T, unsigned int Dim>
+    void equal(SoAInput<Dim, T> a, SoAInput<Dim, T> b, SoASpan<Dim, std::uint8_t> mask) {
+        detail::soa_componentwise(mask, [](T x, T y) { return x == y; }, a, b);
+    }
+
+    /// @brief Branch-free blend: out = mask ? a : b.
+    template<unsigned int Dim, typename T>
+    void select(std::type_identity_t<SoAMask<Dim>> mask, SoAInput<Dim, T> a, SoAInput<Dim, T> b,
+                SoASpan<Dim, T> out) {
+        detail::soa_componentwise(out, [](T x, T y, std::uint8_t m) { return m ? x : y; }, a, b, mask);
+    }
+
+    /// @brief out[i] = 1 if any component of mask element i is set.
+    template<unsigned int Dim, typename B>
+        requires std::is_same_v<std::remove_const_t<B>, std::uint8_t>
+    void any(SoASpan<Dim, B> mask, std::span<std::uint8_t> out) {
+        assert(out.size() >= mask.size() && "Output span is too small.");
+        for (std::size_t i = 0; i < mask.size(); ++i) {
+            out[i] = 0;
+        }
+        for (auto c = 0u; c < Dim; ++c) {
+            const auto m = mask.component(c);
+            for (std::size_t i = 0; i < mask.size(); ++i) {
+                out[i] |= m[i];
+            }
+        }
+    }
+
+    /// @brief out[i] = 1 if every component of mask element i is set.
+    template<unsigned int Dim, typename B>
+        requires std::is_same_v<std::remove_const_t<B>, std::uint8_t>
+    void all(SoASpan<Dim, B> mask, std::span<std::uint8_t> out) {
+        assert(out.size() >= mask.size() && "Output span is too small.");
+        for (std::size_t i = 0; i < mask.size(); ++i) {
+            out[i] = 1;
+        }
+        for (auto c = 0u; c < Dim; ++c) {
+            const auto m = mask.component(c);
+            for (std::size_t i = 0; i < mask.size(); ++i) {
+                out[i] &= m[i];
+            }
+        }
+    }
+
+    /**
+     * @brief out[i] = angle between a[i] and b[i], in [0, pi].
+     *
+     * Same formula as the Vector overload, with the vectorizable `fastmath::atan2`. `Dim` is
+     * explicit as the output is scalar: `angle_between<3>(a, b, angles)`.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void angle_between(SoAInput<Dim, T> a, SoAInput<Dim, T> b, std::span<T> out) {
+        assert(b.size() >= a.size() && out.size() >= a.size() && "Span sizes do not match.");
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = detail::angle_between(a.load(i), b.load(i), [](T y, T x) { return fastmath::atan2(y, x); });
+        }
+    }
+
+    namespace detail {
+        /// Elements per block of the two-pass geometric kernels (fits the weights in L1).
+        inline constexpr std::size_t geometric_block_size = 256;
+
+        /**
+         * out[i] = a[i] * wa + b[i] * wb with (wa, wb) = weights(i, a[i], b[i]), in two passes per
+         * block: the weights are computed into local arrays, then each component is one
+         * streaming loop. Splitting keeps every loop down to a few streams, within the alias
+         * checks the vectorizer is willing to emit, and lets `out` alias `a` or `b`.
+         */
+        template<unsigned int Dim, typename T, typename Weights>
+        void soa_weighted_sum(SoASpan<Dim, const T> a, SoASpan<Dim, const T> b, SoASpan<Dim, T> out,
+                              Weights &&weights) {
+            const auto n = a.size();
+            assert(b.size() >= n && out.size() >= n && "Span sizes do not match.");
+            std::array<T, geometric_block_size> wa, wb;
+            for (std::size_t begin = 0; begin < n; begin += geometric_block_size) {
+                const auto count = std::min(geometric_block_size, n - begin);
+                for (std::size_t i = 0; i < count; ++i) {
+                    const auto w = weights(begin + i, a.load(begin + i), b.load(begin + i));
+                    wa[i] = w[0];
+                    wb[i] = w[1];
+                }
+                for (auto c = 0u; c < Dim; ++c) {
+                    const auto src_a = a.component(c).subspan(begin, count);
+                    const auto src_b = b.component(c).subspan(begin, count);
+                    const auto dst = out.component(c).subspan(begin, count);
+                    for (std::size_t i = 0; i < count; ++i) {
+                        dst[i] = src_a[i] * wa[i] + src_b[i] * wb[i];
+                    }
+                }
+            }
+        }
+
+        /// Branch-free slerp weights of one pair of unit vectors.
+        template<unsigned int Dim, typename T>
+        std::array<T, 2> slerp_weights(const Vector<Dim, T> &a, const Vector<Dim, T> &b, T t) {
+            const auto theta = angle_between(a, b, [](T y, T x) { return fastmath::atan2(y, x); });
+            // Below the threshold the lerp weights are exact to rounding; select them instead of dividing by ~0.
+            const auto small = theta < std::sqrt(std::numeric_limits<T>::epsilon());
+            // theta is in [0, pi]: the reduced kernels need no libm fallback for large arguments.
+            const auto sine = [](T x) { return fastmath::detail::sin_reduced<MathAccuracy::Precise>(x); };
+            const auto inv_s = T(1) / sine(fastmath::blend(small, T(1), theta));
+            return {fastmath::blend(small, T(1) - t, sine((T(1) - t) * theta) * inv_s),
+                    fastmath::blend(small, t, sine(t * theta) * inv_s)};
+        }
+    } // namespace detail
+
+    /// @brief out = slerp(a, b, t) of unit vectors with one t for every element.
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void slerp(SoAInput<Dim, T> a, SoAInput<Dim, T> b, std::type_identity_t<T> t, SoASpan<Dim, T> out) {
+        detail::soa_weighted_sum(a, b, out, [t](std::size_t, const Vector<Dim, T> &x, const Vector<Dim, T> &y) {
+            return detail::slerp_weights(x, y, t);
+        });
+    }
+
+    /// @brief out[i] = slerp(a[i], b[i], t[i]) of unit vectors.
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void slerp(SoAInput<Dim, T> a, SoAInput<Dim, T> b, std::span<const std::type_identity_t<T>> t,
+               SoASpan<Dim, T> out) {
+        assert(t.size() >= a.size() && "Span sizes do not match.");
+        detail::soa_weighted_sum(a, b, out, [t](std::size_t i, const Vector<Dim, T> &x, const Vector<Dim, T> &y) {
+            return detail::slerp_weights(x, y, t[i]);
+        });
+    }
+
+    /// @brief out[i] = reflect(v[i], n[i]); normals need not be unit.
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void reflect(SoAInput<Dim, T> v, SoAInput<Dim, T> n, SoASpan<Dim, T> out) {
+        detail::soa_weighted_sum(v, n, out, [](std::size_t, const Vector<Dim, T> &x, const Vector<Dim, T> &normal) {
+            return std::array<T, 2>{T(1), T(-2) * x.dot(normal) / normal.squared_mag()};
+        });
+    }
+
+    /**
+     * @brief out[i] = refract(incident[i], n[i], eta): zero vector on total internal reflection.
+     *
+     * Total internal reflection zeroes both weights instead of branching, so the loop
+     * still vectorizes.
+     */
+    template<unsigned int Dim, typename T>
+        requires std::is_floating_point_v<T>
+    void refract(SoAInput<Dim, T> incident, SoAInput<Dim, T> n, std::type_identity_t<T> eta, SoASpan<Dim, T> out) {
+        detail::soa_weighted_sum(incident, n, out, [eta](std::size_t, const Vector<Dim, T> &i, const Vector<Dim, T> &normal) {
+            const auto cos_i = normal.dot(i);
+            const auto k = T(1) - eta * eta * (T(1) - cos_i * cos_i);
+            const auto transmitted = k < 0 ? T(0) : T(1);
+            const auto root = std::sqrt(k < 0 ? T(0) : k);
+            return std::array<T, 2>{eta * transmitted, -(eta * cos_i + root) * transmitted};
+        });
+    }
+
+    /**
+     * @name 2D kernels
+     * Over `SoAArray<2, T>`: x and y are separate streams, so one register holds the same
+     * component of 4 (SSE float, AVX double) or 8 (AVX float) vectors.
+     * @{
+     */
+
+    /// @brief out[i] = a[i].perp_dot(b[i]).
+    template<typename T>
+    void perp_dot(SoAInput<2, T> a, SoAInput<2, T> b, std::span<T> out) {
+        assert(b.size() >= a.size() && out.size() >= a.size() && "Span sizes do not match.");
+        const auto ax = a.component(0), ay = a.component(1), bx = b.component(0), by = b.component(1);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = ax[i] * by[i] - ay[i] * bx[i];
+        }
+    }
+
+    /// @brief out[i] = v[i].perp().
+    template<typename T>
+    void perp(SoAInput<2, T> v, SoASpan<2, T> out) {
+        assert(out.size() >= v.size() && "Span sizes do not match.");
+        const auto x = v.component(0), y = v.component(1);
+        const auto ox = out.component(0), oy = out.component(1);
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            // Read both components first so that `v` and `out` may alias.
+            const auto px = x[i], py = y[i];
+            ox[i] = -py;
+            oy[i] = px;
+        }
+    }
+
+    /// @brief out[i] = v[i].rotated(rotation) with the unit complex number (cos a, sin a).
+    template<typename T>
+    void rotate(SoAInput<2, T> v, const Vector<2, T> &rotation, SoASpan<2, T> out) {
+        assert(out.size() >= v.size() && "Span sizes do not match.");
+        const auto c = rotation[0], s = rotation[1];
+        const auto x = v.component(0), y = v.component(1);
+        const auto ox = out.component(0), oy = out.component(1);
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            const auto px = x[i], py = y[i];
+            ox[i] = c * px - s * py;
+            oy[i] = s * px + c * py;
+        }
+    }
+
+    /// @brief out[i] = v[i] rotated counter-clockwise by `angle` radians.
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    void rotate(SoAInput<2, T> v, std::type_identity_t<T> angle, SoASpan<2, T> out) {
+        rotate(v, Vector<2, T>(std::cos(angle), std::sin(angle)), out);
+    }
+
+    /// @brief out[i] = v[i] rotated counter-clockwise by angles[i] radians.
+    template<typename T>
+        requires std::is_floating_point_v<T>
+    void rotate(SoAInput<2, T> v, std::span<const std::type_identity_t<T>> angles, SoASpan<2, T> out) {
+        assert(angles.size() >= v.size() && out.size() >= v.size() && "Span sizes do not match.");
+        const auto x = v.component(0), y = v.component(1);
+        const auto ox = out.component(0), oy = out.component(1);
+        fastmath::detail::trig_blocks<MathAccuracy::Precise>(angles.first(v.size()), [&](std::size_t i, auto reduced) {
+            T s, c;
+            if constexpr (reduced) {
+                fastmath::detail::sincos_reduced<MathAccuracy::Precise>(angles[i], s, c);
+            } else {
+                fastmath::sincos(angles[i], s, c);
+            }
+            const auto px = x[i], py = y[i];
+            ox[i] = c * px - s * py;
+            oy[i] = s * px + c * py;
+        });
+    }
+
+    /**
+     * @brief out[i] = orientation(a[i], b[i], c[i]): 1, -1 or 0 (counter-clockwise, clockwise, collinear).
+     * @note The scalar type is explicit: `orientation<float>(a, b, c, out)`.
+     */
+    template<typename T>
+    void orientation(SoAInput<2, T> a, SoAInput<2, T> b, SoAInput<2, T> c, std::span<std::int8_t> out) {
+        assert(b.size() >= a.size() && c.size() >= a.size() && out.size() >= a.size() && "Span sizes do not match.");
+        const auto ax = a.component(0), ay = a.component(1);
+        const auto bx = b.component(0), by = b.component(1);
+        const auto cx = c.component(0), cy = c.component(1);
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            const auto d = (bx[i] - ax[i]) * (cy[i] - ay[i]) - (by[i] - ay[i]) * (cx[i] - ax[i]);
+            out[i] = static_cast<std::int8_t>((d > 0) - (d < 0));
+        }
+    }
+
+    /** @} */
+} // namespace Geometry
+
+#endif // VECTORBATCH_H
@@ -0,0 +1,449 @@
+/**
+ * @file VectorBlockArray.h
+ * @brief Array of vectors stored as AoSoA: blocks of `Width` elements, SoA inside a block.
+ *
+ * A block holds x[Width], y[Width], z[Width]... contiguously. Kernels see one register
+ * worth of each component per block, like SoA, while all components of an element sit in
+ * the same `Dim * Width * sizeof(T)` bytes, like AoS: touching a few random elements costs
+ * one or two cache lines per element instead of `Dim` with separate component arrays.
+ *
+ * Time per element relative to AoS `std::vector<Vector3f>`, one core, g++ 12 -O3
+ * -fno-math-errno -march=native (AVX2), 16K elements (in L2) and 16M elements (in DRAM).
+ * Medians of several runs of `bench layouts` (bench/Layouts.cpp, -DBENCH_NATIVE=ON); runs
+ * differ by up to 0.3 on a shared machine:
+ *
+ * | Operation                  | SoA, L2 | AoSoA, L2 | SoA, DRAM | AoSoA, DRAM |
+ * |----------------------------|---------|-----------|-----------|-------------|
+ * | dot                        | 0.73    | 0.53      | 0.77      | 1.0         |
+ * | cross                      | 1.2     | 0.68      | 1.0       | 1.3         |
+ * | normalize                  | 0.23    | 0.16      | 0.56      | 0.57        |
+ * | random access (load + sum) | 1.2     | 1.15      | 2.3       | 1.1         |
+ *
+ * In cache, AoSoA is the fastest layout: its kernels check one input block against one
+ * output block, while the SoA cross loop reads and writes six arrays and loses its gain to
+ * runtime alias checks. Streaming through DRAM, the kernels are bound by bandwidth and no
+ * layout wins. Random accesses are bound by latency: AoSoA stays at AoS speed, while SoA
+ * pays three cache misses per element.
+ *
+ * Iterating the array yields its elements as `Vector`s, lane by lane; `blocks()` gives the
+ * raw blocks to kernels. The last block is padded to `Width`; padding lanes are kept at zero
+ * by every kernel, so kernels run over whole blocks without a scalar tail. Whole-array
+ * outputs must have the size of the inputs and may alias them.
+ * Requires C++20
+ */
+
+#ifndef VECTORBLOCKARRAY_H
+#define VECTORBLOCKARRAY_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "FastMath.h"
+#include "Vector.h"
+
+namespace Geometry {
+    /// @brief Lanes of a block: one SIMD register of 4-byte floats on AVX, of doubles on AVX2.
+    template<typename T>
+    inline constexpr unsigned int default_block_width = static_cast<unsigned int>(32 / sizeof(T));
+
+    /**
+     * @struct VectorBlock
+     * @brief `Width` vectors stored component by component: components[c][lane].
+     */
+    template<unsigned int Dim, typename T, unsigned int Width>
+    struct alignas(std::min<std::size_t>(64, Width * sizeof(T))) VectorBlock {
+        std::array<std::array<T, Width>, Dim> components{};
+
+        /// @brief Assemble the vector of lane `lane`.
+        [[nodiscard]] constexpr Vector<Dim, T> load(unsigned int lane) const {
+            Vector<Dim, T> v;
+            for (auto c = 0u; c < Dim; ++c) {
+                v[c] = components[c][lane];
+            }
+            return v;
+        }
+
+        /// @brief Scatter `v` into lane `lane`.
+        constexpr void store(unsigned int lane, const Vector<Dim, T> &v) {
+            for (auto c = 0u; c < Dim; ++c) {
+                components[c][lane] = v[c];
+            }
+        }
+    };
+
+    /**
+     * @class VectorBlockArray
+     * @brief Owning AoSoA storage for `Dim`-dimensional vectors.
+     *
+     * @tparam Width Elements per block, a power of two (one SIMD register of T by default).
+     */
+    template<unsigned int Dim, typename T, unsigned int Width = default_block_width<T>>
+        requires std::is_arithmetic_v<T> && (Width > 0 && (Width & (Width - 1)) == 0)
+    class VectorBlockArray {
+    public:
+        using Block = VectorBlock<Dim, T, Width>;
+        using value_type = Vector<Dim, T>;
+
+        /// @brief Element of a mutable array: reads assemble the vector, assignments scatter it.
+        class reference {
+        public:
+            reference(Block &block, unsigned int lane) : _block(&block), _lane(lane) {
+            }
+
+            reference(const reference &) = default;
+
+            operator value_type() const {
+                return _block->load(_lane);
+            }
+
+            const reference &operator=(const value_type &v) const {
+                _block->store(_lane, v);
+                return *this;
+            }
+
+            const reference &operator=(const reference &other) const {
+                return *this = static_cast<value_type>(other);
+            }
+
+            /// @brief Exchange the two elements, as `std::vector<bool>::reference` does.
+            friend void swap(reference a, reference b) {
+                const value_type v = a;
+                a = b;
+                b = v;
+            }
+
+        private:
+            Block *_block;
+            unsigned int _lane;
+        };
+
+        /**
+         * @brief Random access over the elements, yielding `reference` or, if `Const`, vectors.
+         *
+         * Like `std::vector<bool>::iterator`, it claims the random access category although it
+         * yields proxies, so that std::sort and std::reverse accept it.
+         */
+        template<bool Const>
+        class lane_iterator {
+        public:
+            using iterator_concept = std::random_access_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = Vector<Dim, T>;
+            using difference_type = std::ptrdiff_t;
+            using BlockPointer = std::conditional_t<Const, const Block *, Block *>;
+
+            lane_iterator() = default;
+
+            lane_iterator(BlockPointer blocks, std::size_t index) : _blocks(blocks), _index(index) {
+            }
+
+            /// @brief A mutable iterator converts to a const one.
+            operator lane_iterator<true>() const requires (!Const) {
+                return {_blocks, _index};
+            }
+
+            [[nodiscard]] auto operator*() const {
+                const auto lane = static_cast<unsigned int>(_index % Width);
+                if constexpr (Const) {
+                    return _blocks[_index / Width].load(lane);
+                } else {
+                    return reference(_blocks[_index / Width], lane);
+                }
+            }
+
+            [[nodiscard]] auto operator[](difference_type n) const {
+                return *(*this + n);
+            }
+
+            lane_iterator &operator++() {
+                ++_index;
+                return *this;
+            }
+
+            lane_iterator operator++(int) {
+                auto copy = *this;
+                ++_index;
+                return copy;
+            }
+
+            lane_iterator &operator--() {
+                --_index;
+                return *this;
+            }
+
+            lane_iterator operator--(int) {
+                auto copy = *this;
+                --_index;
+                return copy;
+            }
+
+            lane_iterator &operator+=(difference_type n) {
+                _index = static_cast<std::size_t>(static_cast<difference_type>(_index) + n);
+                return *this;
+            }
+
+            lane_iterator &operator-=(difference_type n) {
+                return *this += -n;
+            }
+
+            [[nodiscard]] friend lane_iterator operator+(lane_iterator it, difference_type n) {
+                return it += n;
+            }
+
+            [[nodiscard]] friend lane_iterator operator+(difference_type n, lane_iterator it) {
+                return it += n;
+            }
+
+            [[nodiscard]] friend lane_iterator operator-(lane_iterator it, difference_type n) {
+                return it -= n;
+            }
+
+            [[nodiscard]] friend difference_type operator-(const lane_iterator &a, const lane_iterator &b) {
+                return static_cast<difference_type>(a._index) - static_cast<difference_type>(b._index);
+            }
+
+            [[nodiscard]] friend bool operator==(const lane_iterator &a, const lane_iterator &b) {
+                return a._index == b._index;
+            }
+
+            [[nodiscard]] friend std::strong_ordering operator<=>(const lane_iterator &a, const lane_iterator &b) {
+                return a._index <=> b._index;
+            }
+
+        private:
+            BlockPointer _blocks = nullptr;
+            std::size_t _index = 0;
+        };
+
+        using iterator = lane_iterator<false>;
+        using const_iterator = lane_iterator<true>;
+
+        VectorBlockArray() = default;
+
+        /// @brief Storage for `count` zero-initialized vectors.
+        explicit VectorBlockArray(std::size_t count) {
+            resize(count);
+        }
+
+        /// @brief Copy of an AoS array.
+        explicit VectorBlockArray(std::span<const Vector<Dim, T>> vectors) {
+            resize(vectors.size());
+            for (std::size_t i = 0; i < vectors.size(); ++i) {
+                store(i, vectors[i]);
+            }
+        }
+
+        void resize(std::size_t count) {
+            _blocks.resize((count + Width - 1) / Width);
+            // Clear the lanes dropped by a shrink so the padding stays zero.
+            for (auto i = count; i < _blocks.size() * Width; ++i) {
+                store_unchecked(i, Vector<Dim, T>());
+            }
+            _size = count;
+        }
+
+        [[nodiscard]] std::size_t size() const {
+            return _size;
+        }
+
+        [[nodiscard]] std::size_t block_count() const {
+            return _blocks.size();
+        }
+
+        /// @brief Block `b`, holding elements [b * Width, (b + 1) * Width).
+        [[nodiscard]] Block &block(std::size_t b) {
+            return _blocks[b];
+        }
+
+        [[nodiscard]] const Block &block(std::size_t b) const {
+            return _blocks[b];
+        }
+
+        /// @brief All blocks; the last one may be partly padding.
+        [[nodiscard]] std::span<Block> blocks() {
+            return _blocks;
+        }
+
+        [[nodiscard]] std::span<const Block> blocks() const {
+            return _blocks;
+        }
+
+        /// @brief Iterate over the elements; kernels should loop over `blocks()` instead.
+        [[nodiscard]] iterator begin() {
+            return {_blocks.data(), 0};
+        }
+
+        [[nodiscard]] iterator end() {
+            return {_blocks.data(), _size};
+        }
+
+        [[nodiscard]] const_iterator begin() const {
+            return {_blocks.data(), 0};
+        }
+
+        [[nodiscard]] const_iterator end() const {
+            return {_blocks.data(), _size};
+        }
+
+        /// @brief Assemble vector `i`.
+        [[nodiscard]] value_type load(std::size_t i) const {
+            assert(i < _size && "Index out of range.");
+            return _blocks[i / Width].load(static_cast<unsigned int>(i % Width));
+        }
+
+        /// @brief Scatter vector `v` into slot `i`.
+        void store(std::size_t i, const value_type &v) {
+            assert(i < _size && "Index out of range.");
+            store_unchecked(i, v);
+        }
+
+        /// @brief Copy every element into an AoS array.
+        void copy_to(std::span<Vector<Dim, T>> out) const {
+            assert(out.size() >= _size && "Output span is too small.");
+            for (std::size_t i = 0; i < _size; ++i) {
+                out[i] = load(i);
+            }
+        }
+
+    private:
+        void store_unchecked(std::size_t i, const value_type &v) {
+            _blocks[i / Width].store(static_cast<unsigned int>(i % Width), v);
+        }
+
+        std::vector<Block> _blocks;
+        std::size_t _size = 0;
+    };
+
+    namespace detail {
+        /// out.block(k).components[c][l] = fn(in.block(k).components[c][l]...) over whole blocks.
+        template<unsigned int Dim, typename T, unsigned int Width, typename Fn, typename... In>
+        void block_componentwise(VectorBlockArray<Dim, T, Width> &out, Fn &&fn, const In &... in) {
+            assert(((in.size() == out.size()) && ...) && "Array sizes do not match.");
+            for (std::size_t k = 0; k < out.block_count(); ++k) {
+                auto &dst = out.block(k).components;
+                for (auto c = 0u; c < Dim; ++c) {
+                    for (auto l = 0u; l < Width; ++l) {
+                        dst[c][l] = fn(in.block(k).components[c][l]...);
+                    }
+                }
+            }
+            // `fn` need not map zero to zero (0 * inf is NaN): clear the padding lanes again.
+            for (auto i = out.size(); i < out.block_count() * Width; ++i) {
+                for (auto c = 0u; c < Dim; ++c) {
+                    out.block(i / Width).components[c][i % Width] = T(0);
+                }
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @name AoSoA kernels
+     * Counterparts of the Vector operations over whole blocks; the lane loops have the
+     * register width as trip count and vectorize without a remainder.
+     * @{
+     */
+
+    /// @brief out = a + b.
+    template<unsigned int Dim, typename T, unsigned int Width>
+    void add(const VectorBlockArray<Dim, T, Width> &a, const VectorBlockArray<Dim, T, Width> &b,
+             VectorBlockArray<Dim, T, Width> &out) {
+        detail::block_componentwise(out, [](T x, T y) { return x + y; }, a, b);
+    }
+
+    /// @brief out = a - b.
+    template<unsigned int Dim, typename T, unsigned int Width>
+    void subtract(const VectorBlockArray<Dim, T, Width> &a, const VectorBlockArray<Dim, T, Width> &b,
+                  VectorBlockArray<Dim, T, Width> &out) {
+        detail::block_componentwise(out, [](T x, T y) { return x - y; }, a, b);
+    }
+
+    /// @brief out = a * scalar.
+    template<unsigned int Dim, typename T, unsigned int Width>
+    void scale(const VectorBlockArray<Dim, T, Width> &a, std::type_identity_t<T> scalar,
+               VectorBlockArray<Dim, T, Width> &out) {
+        detail::block_componentwise(out, [scalar](T x) { return x * scalar; }, a);
+    }
+
+    /// @brief out[i] = a[i] . b[i].
+    template<unsigned int Dim, typename T, unsigned int Width>
+    void dot(const VectorBlockArray<Dim, T, Width> &a, const VectorBlockArray<Dim, T, Width> &b, std::span<T> out) {
+        assert(b.size() == a.size() && out.size() >= a.size() && "Array sizes do not match.");
+        const auto lane_dot = [](const VectorBlock<Dim, T, Width> &x, const VectorBlock<Dim, T, Width> &y, unsigned int l) {
+            T r = 0;
+            for (auto c = 0u; c < Dim; ++c) {
+                r += x.components[c][l] * y.components[c][l];
+            }
+            return r;
+        };
+        const auto full = a.size() / Width;
+        for (std::size_t k = 0; k < full; ++k) {
+            for (auto l = 0u; l < Width; ++l) {
+                out[k * Width + l] = lane_dot(a.block(k), b.block(k), l);
+            }
+        }
+        for (auto i = full * Width; i < a.size(); ++i) {
+            out[i] = lane_dot(a.block(full), b.block(full), static_cast<unsigned int>(i % Width));
+        }
+    }
+
+    /// @brief out[i] = a[i] x b[i].
+    template<typename T, unsigned int Width>
+    void cross(const VectorBlockArray<3, T, Width> &a, const VectorBlockArray<3, T, Width> &b,
+               VectorBlockArray<3, T, Width> &out) {
+        assert(b.size() == a.size() && out.size() == a.size() && "Array sizes do not match.");
+        for (std::size_t k = 0; k < a.block_count(); ++k) {
+            const auto &x = a.block(k).components, &y = b.block(k).components;
+            std::array<std::array<T, Width>, 3> result;
+            for (auto l = 0u; l < Width; ++l) {
+                result[0][l] = x[1][l] * y[2][l] - x[2][l] * y[1][l];
+                result[1][l] = x[2][l] * y[0][l] - x[0][l] * y[2][l];
+                result[2][l] = x[0][l] * y[1][l] - x[1][l] * y[0][l];
+            }
+            out.block(k).components = result;
+        }
+    }
+
+    /**
+     * @brief out[i] = a[i].normalized(); zero vectors (and the padding) stay zero.
+     * @note Vectorizes with -fno-math-errno, which drops the errno check of std::sqrt.
+     */
+    template<unsigned int Dim, typename T, unsigned int Width>
+        requires std::is_floating_point_v<T>
+    void normalize(const VectorBlockArray<Dim, T, Width> &a, VectorBlockArray<Dim, T, Width> &out) {
+        assert(out.size() == a.size() && "Array sizes do not match.");
+        for (std::size_t k = 0; k < a.block_count(); ++k) {
+            const auto &src = a.block(k).components;
+            auto &dst = out.block(k).components;
+            // One lane loop loading every component: split into per-component loops, GCC
+            // unrolls the short lane loops and leaves the square roots scalar.
+            for (auto l = 0u; l < Width; ++l) {
+                std::array<T, Dim> v;
+                T squared = 0;
+                for (auto c = 0u; c < Dim; ++c) {
+                    v[c] = src[c][l];
+                    squared += v[c] * v[c];
+                }
+                const auto inv_length = fastmath::blend(squared > 0, T(1) / std::sqrt(squared), T(0));
+                for (auto c = 0u; c < Dim; ++c) {
+                    dst[c][l] = v[c] * inv_length;
+                }
+            }
+        }
+    }
+
+    /** @} */
+
+    // Typedefs for common use cases.
+    using Vector3BlockArray = VectorBlockArray<3, double>;
+    using Vector3fBlockArray = VectorBlockArray<3, float>;
+} // namespace Geometry
+
+#endif // VECTORBLOCKARRAY_H
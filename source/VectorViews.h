@@ -0,0 +1,493 @@
+/**
+ * @file VectorViews.h
+ * @brief Lazy range adaptors over ranges of `Vector`, fused into one chunked loop when materialized.
+ *
+ * `views::normalized`, `views::scaled(s)`, `views::translated(offset)`,
+ * `views::project_onto(axis)`, `views::transform_points(m)` and `views::transform_directions(m)`
+ * compose with `|`:
+ * @code
+ * auto moved = positions | views::transform_points(model) | views::project_onto(axis);
+ * for (const auto &p : moved) { ... }      // lazy, one element at a time
+ * const auto result = to_vector(moved);    // fused, chunked
+ * @endcode
+ * Each adaptor is a stage; piping a stage into a pipeline view appends it instead of nesting
+ * one more view, so a chain of adaptors stays one view over the source. Iterating it runs
+ * every stage on each element in turn, without temporary arrays.
+ *
+ * `materialize` and `to_vector` over a contiguous source of vectors split it across threads
+ * (`threads > 1` or a parallel execution policy) with `parallel_for`. Built without AVX2,
+ * each piece runs a different loop: chunks of `pipeline_chunk_size` elements are transposed
+ * to SoA on the stack (Transpose.h), every stage runs over the chunk as a branch-free lane
+ * loop while it sits in L1, and the chunk is transposed back into the output. The lane loops
+ * vectorize like the VectorBatch.h kernels (those calling std::sqrt only with
+ * -fno-math-errno). Other sources fall back to the element loop on the calling thread.
+ * Both paths compute an element with the same operations, so results only differ where the
+ * compiler contracts multiply-adds differently.
+ *
+ * ns per element for `transform_points(Transform3f) | normalized | project_onto(axis)` over
+ * Vector3f, one core, g++ 12 -O3 -fno-math-errno; "eager" runs one loop per operation
+ * through a temporary array (`bench views`):
+ *
+ * | Build                 | Size       | Element loop | Chunked loop | Eager |
+ * |-----------------------|------------|--------------|--------------|-------|
+ * | SSE2 (default)        | 16K (L2)   | 5.5          | 3.0          | 8.3   |
+ * | SSE2 (default)        | 16M (DRAM) | 6.6          | 5.8          | 10.4  |
+ * | -march=native (AVX2)  | 16K (L2)   | 1.1          | 2.1          | 4.9   |
+ * | -march=native (AVX2)  | 16M (DRAM) | 2.4          | 4.7          | 8.6   |
+ *
+ * With AVX2, GCC vectorizes the element loop itself with cross-lane permutes, and the two
+ * transposes of the chunked loop (about 1.5 memcpy of the array) no longer pay for
+ * themselves, so `materialize` keeps the element loop when `__AVX2__` is defined.
+ * Requires C++20
+ */
+
+#ifndef VECTORVIEWS_H
+#define VECTORVIEWS_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Matrix.h"
+#include "Parallel.h"
+#include "SoA.h"
+#include "Transform3.h"
+#include "Transpose.h"
+#include "Vector.h"
+#include "VectorBatch.h"
+
+namespace Geometry {
+    /// @brief Elements per chunk of a fused pipeline loop (the SoA chunk of 3D doubles takes 6 KB).
+    inline constexpr std::size_t pipeline_chunk_size = 256;
+
+    /// @brief Whether `materialize` runs the chunked SoA loop; the element loop is faster with AVX2.
+#if defined(__AVX2__)
+    inline constexpr bool pipeline_chunked = false;
+#else
+    inline constexpr bool pipeline_chunked = true;
+#endif
+
+    namespace detail {
+        /*
+         * Stages: `stage(v)` transforms one vector, `stage(chunk)` transforms a SoA chunk in place.
+         * Chunk loops read every component of an element before writing any.
+         */
+
+        /// v / |v|, without the assert of `Vector::normalized`, whose branch keeps the element loop scalar.
+        struct NormalizeStage {
+            template<unsigned int Dim, typename T>
+                requires std::is_floating_point_v<T>
+            [[nodiscard]] Vector<Dim, T> operator()(const Vector<Dim, T> &v) const {
+                return v / std::sqrt(v.squared_mag());
+            }
+
+            template<unsigned int Dim, typename T>
+                requires std::is_floating_point_v<T>
+            void operator()(SoASpan<Dim, T> chunk) const {
+                for (std::size_t i = 0; i < chunk.size(); ++i) {
+                    std::array<T, Dim> v;
+                    T squared = 0;
+                    for (auto c = 0u; c < Dim; ++c) {
+                        v[c] = chunk.component(c)[i];
+                        squared += v[c] * v[c];
+                    }
+                    const auto length = std::sqrt(squared);
+                    for (auto c = 0u; c < Dim; ++c) {
+                        chunk.component(c)[i] = v[c] / length;
+                    }
+                }
+            }
+        };
+
+        /// v * factor.
+        template<typename S>
+        struct ScaleStage {
+            S factor;
+
+            template<unsigned int Dim, typename T>
+            [[nodiscard]] constexpr Vector<Dim, T> operator()(const Vector<Dim, T> &v) const {
+                return v * static_cast<T>(factor);
+            }
+
+            template<unsigned int Dim, typename T>
+            void operator()(SoASpan<Dim, T> chunk) const {
+                scale(chunk, static_cast<T>(factor), chunk);
+            }
+        };
+
+        /// v + offset.
+        template<unsigned int Dim, typename T>
+        struct TranslateStage {
+            Vector<Dim, T> offset;
+
+            [[nodiscard]] constexpr Vector<Dim, T> operator()(const Vector<Dim, T> &v) const {
+                return v + offset;
+            }
+
+            void operator()(SoASpan<Dim, T> chunk) const {
+                for (auto c = 0u; c < Dim; ++c) {
+                    const auto component = chunk.component(c);
+                    for (auto &x: component) {
+                        x += offset[c];
+                    }
+                }
+            }
+        };
+
+        /// v.project(axis), with |axis|^2 computed once.
+        template<unsigned int Dim, typename T>
+        struct ProjectStage {
+            Vector<Dim, T> axis;
+            T squared;
+
+            [[nodiscard]] constexpr Vector<Dim, T> operator()(const Vector<Dim, T> &v) const {
+                return axis * (v.dot(axis) / squared);
+            }
+
+            void operator()(SoASpan<Dim, T> chunk) const {
+                for (std::size_t i = 0; i < chunk.size(); ++i) {
+                    T dot = 0;
+                    for (auto c = 0u; c < Dim; ++c) {
+                        dot += chunk.component(c)[i] * axis[c];
+                    }
+                    const auto scalar = dot / squared;
+                    for (auto c = 0u; c < Dim; ++c) {
+                        chunk.component(c)[i] = axis[c] * scalar;
+                    }
+                }
+            }
+        };
+
+        /// 4x4 homogeneous matrix applied to points (w = 1, divided by the result w) or directions (w = 0).
+        template<typename T, bool Point>
+        struct MatrixStage {
+            Matrix<4, 4, T> m;
+
+            [[nodiscard]] constexpr Vector<3, T> operator()(const Vector<3, T> &v) const {
+                if constexpr (Point) {
+                    return transform(m, Geometry::Point<3, T>(v)).vector();
+                } else {
+                    return transform(m, Direction<3, T>(v)).vector();
+                }
+            }
+
+            void operator()(SoASpan<3, T> chunk) const {
+                const auto x = chunk.component(0), y = chunk.component(1), z = chunk.component(2);
+                for (std::size_t i = 0; i < chunk.size(); ++i) {
+                    const auto px = x[i], py = y[i], pz = z[i];
+                    std::array<T, 3> h;
+                    for (auto r = 0u; r < 3; ++r) {
+                        h[r] = m(r, 0) * px + m(r, 1) * py + m(r, 2) * pz;
+                    }
+                    if constexpr (Point) {
+                        const auto w = m(3, 0) * px + m(3, 1) * py + m(3, 2) * pz + m(3, 3);
+                        for (auto r = 0u; r < 3; ++r) {
+                            h[r] = (h[r] + m(r, 3)) / w;
+                        }
+                    }
+                    x[i] = h[0];
+                    y[i] = h[1];
+                    z[i] = h[2];
+                }
+            }
+        };
+
+        /// Affine transform applied to points or directions.
+        template<typename T, bool Point>
+        struct AffineStage {
+            Transform3<T> t;
+
+            [[nodiscard]] constexpr Vector<3, T> operator()(const Vector<3, T> &v) const {
+                return Point ? t.transform_point(v) : t.transform_vector(v);
+            }
+
+            void operator()(SoASpan<3, T> chunk) const {
+                if constexpr (Point) {
+                    t.transform_points(chunk, chunk);
+                } else {
+                    t.transform_vectors(chunk, chunk);
+                }
+            }
+        };
+    } // namespace detail
+
+    template<std::ranges::view V, typename... Stages>
+    class VectorPipelineView;
+
+    namespace detail {
+        template<typename R>
+        inline constexpr bool is_vector_pipeline_view = false;
+
+        template<typename V, typename... Stages>
+        inline constexpr bool is_vector_pipeline_view<VectorPipelineView<V, Stages...>> = true;
+    } // namespace detail
+
+    /**
+     * @class VectorPipeline
+     * @brief Range adaptor closure: a sequence of stages applied to every vector of a range.
+     *
+     * `range | pipeline` gives a `VectorPipelineView`; `pipeline | pipeline` concatenates stages.
+     */
+    template<typename... Stages>
+    class VectorPipeline {
+    public:
+        constexpr explicit VectorPipeline(Stages... stages) : _stages(std::move(stages)...) {
+        }
+
+        /// @brief Apply every stage, in order, to one vector.
+        template<unsigned int Dim, typename T>
+        [[nodiscard]] constexpr Vector<Dim, T> operator()(const Vector<Dim, T> &v) const {
+            return std::apply([&](const auto &... stage) {
+                auto result = v;
+                ((result = stage(result)), ...);
+                return result;
+            }, _stages);
+        }
+
+        /// @brief Apply every stage, in order, to a SoA chunk in place.
+        template<unsigned int Dim, typename T>
+        void operator()(SoASpan<Dim, T> chunk) const {
+            std::apply([&](const auto &... stage) { (stage(chunk), ...); }, _stages);
+        }
+
+        [[nodiscard]] constexpr const std::tuple<Stages...> &stages() const {
+            return _stages;
+        }
+
+        /// @brief The stages of `first`, then those of `next`.
+        template<typename... Next>
+        [[nodiscard]] friend constexpr VectorPipeline<Stages..., Next...> operator|(const VectorPipeline &first,
+                                                                                    const VectorPipeline<Next...> &next) {
+            return std::make_from_tuple<VectorPipeline<Stages..., Next...>>(std::tuple_cat(first._stages, next.stages()));
+        }
+
+        /// @brief Lazy view applying the stages to the elements of `range`.
+        template<std::ranges::viewable_range R>
+            requires (!detail::is_vector_pipeline_view<std::remove_cvref_t<R>>)
+        [[nodiscard]] friend constexpr auto operator|(R &&range, const VectorPipeline &pipeline) {
+            return VectorPipelineView<std::views::all_t<R>, Stages...>(std::views::all(std::forward<R>(range)), pipeline);
+        }
+
+    private:
+        std::tuple<Stages...> _stages;
+    };
+
+    /**
+     * @class VectorPipelineView
+     * @brief Lazy view of the vectors of `V` passed through a pipeline of stages.
+     *
+     * Iterating it evaluates the stages element by element; `materialize` and `to_vector`
+     * evaluate it chunk by chunk.
+     */
+    template<std::ranges::view V, typename... Stages>
+    class VectorPipelineView : public std::ranges::view_interface<VectorPipelineView<V, Stages...>> {
+    public:
+        using Pipeline = VectorPipeline<Stages...>;
+        using element_type = std::remove_cvref_t<std::invoke_result_t<const Pipeline &, std::ranges::range_reference_t<V>>>;
+
+        constexpr VectorPipelineView(V base, const Pipeline &pipeline)
+            : _view(std::move(base), pipeline), _pipeline(pipeline) {
+        }
+
+        [[nodiscard]] constexpr auto begin() {
+            return _view.begin();
+        }
+
+        [[nodiscard]] constexpr auto end() {
+            return _view.end();
+        }
+
+        [[nodiscard]] constexpr auto begin() const requires std::ranges::range<const V> {
+            return _view.begin();
+        }
+
+        [[nodiscard]] constexpr auto end() const requires std::ranges::range<const V> {
+            return _view.end();
+        }
+
+        [[nodiscard]] constexpr auto size() const requires std::ranges::sized_range<const V> {
+            return _view.size();
+        }
+
+        [[nodiscard]] constexpr const Pipeline &pipeline() const {
+            return _pipeline;
+        }
+
+        /// @brief Append the stages of `next`; the result is still one view over the source.
+        template<typename... Next>
+        [[nodiscard]] friend constexpr auto operator|(VectorPipelineView view, const VectorPipeline<Next...> &next) {
+            auto pipeline = view._pipeline | next;
+            return VectorPipelineView<V, Stages..., Next...>(std::move(view)._view.base(), pipeline);
+        }
+
+    private:
+        // The transform view holds its own copy of the pipeline but does not expose it.
+        std::ranges::transform_view<V, Pipeline> _view;
+        Pipeline _pipeline;
+    };
+
+    namespace detail {
+        /// Run `pipeline` over `in` one SoA chunk at a time; `out` may alias `in`.
+        template<typename Pipeline, unsigned int Dim, typename T>
+        void run_pipeline_chunks(const Pipeline &pipeline, std::span<const Vector<Dim, T>> in,
+                                 std::span<Vector<Dim, T>> out) {
+            std::array<std::array<T, pipeline_chunk_size>, Dim> lanes;
+            for (std::size_t k = 0; k < in.size(); k += pipeline_chunk_size) {
+                const auto n = std::min(pipeline_chunk_size, in.size() - k);
+                std::array<std::span<T>, Dim> components;
+                for (auto c = 0u; c < Dim; ++c) {
+                    components[c] = std::span<T>(lanes[c].data(), n);
+                }
+                const SoASpan<Dim, T> chunk(components);
+                aos_to_soa(in.subspan(k, n), chunk);
+                pipeline(chunk);
+                soa_to_aos(SoASpan<Dim, const T>(chunk), out.subspan(k, n));
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @brief Evaluate `view` into `out`, which may be the source itself.
+     *
+     * A contiguous source of vectors is split across `threads` threads, each running the
+     * chunked loop (or the element loop when `pipeline_chunked` is false); other sources are
+     * iterated element by element on the calling thread.
+     */
+    template<std::ranges::view V, typename... Stages>
+    void materialize(const VectorPipelineView<V, Stages...> &view,
+                     std::span<typename VectorPipelineView<V, Stages...>::element_type> out,
+                     unsigned int threads = 1) {
+        using Element = typename VectorPipelineView<V, Stages...>::element_type;
+        if constexpr (std::ranges::contiguous_range<const V> && std::ranges::sized_range<const V>
+                      && std::is_same_v<std::ranges::range_value_t<const V>, Element>) {
+            const auto n = static_cast<std::size_t>(view.size());
+            assert(out.size() >= n && "Output span is too small.");
+            const std::span<const Element> in(std::to_address(view.begin().base()), n);
+            const auto &pipeline = view.pipeline();
+            parallel_for(n, [&](std::size_t begin, std::size_t end, unsigned int) {
+                if constexpr (pipeline_chunked) {
+                    detail::run_pipeline_chunks(pipeline, in.subspan(begin, end - begin), out.subspan(begin, end - begin));
+                } else {
+                    for (auto i = begin; i < end; ++i) {
+                        out[i] = pipeline(in[i]);
+                    }
+                }
+            }, threads);
+        } else {
+            std::size_t i = 0;
+            for (const auto &v: view) {
+                assert(i < out.size() && "Output span is too small.");
+                out[i++] = v;
+            }
+        }
+    }
+
+    namespace detail {
+        template<std::ranges::view V, typename... Stages, typename Policy>
+        [[nodiscard]] unsigned int pipeline_thread_count(const Policy &policy, const VectorPipelineView<V, Stages...> &view) {
+            if constexpr (std::ranges::sized_range<const V>) {
+                return policy_thread_count(policy, static_cast<std::size_t>(view.size()),
+                                           (pipeline_chunked ? element_cost_ns::pipeline_transpose : 0.0)
+                                           + element_cost_ns::pipeline_stage * sizeof...(Stages));
+            } else {
+                return 1;
+            }
+        }
+    } // namespace detail
+
+    /// @brief `materialize` on as many threads as `policy` allows for the size of the view.
+    template<ExecutionPolicy Policy, std::ranges::view V, typename... Stages>
+    void materialize(const Policy &policy, const VectorPipelineView<V, Stages...> &view,
+                     std::span<typename VectorPipelineView<V, Stages...>::element_type> out) {
+        materialize(view, out, detail::pipeline_thread_count(policy, view));
+    }
+
+    /// @brief Evaluate `view` into a new vector; see `materialize`.
+    template<std::ranges::view V, typename... Stages>
+    [[nodiscard]] auto to_vector(const VectorPipelineView<V, Stages...> &view, unsigned int threads = 1) {
+        using Element = typename VectorPipelineView<V, Stages...>::element_type;
+        std::vector<Element> result;
+        if constexpr (std::ranges::sized_range<const V>) {
+            result.resize(static_cast<std::size_t>(view.size()));
+            materialize(view, std::span<Element>(result), threads);
+        } else {
+            for (const auto &v: view) {
+                result.push_back(v);
+            }
+        }
+        return result;
+    }
+
+    /// @brief `to_vector` on as many threads as `policy` allows for the size of the view.
+    template<ExecutionPolicy Policy, std::ranges::view V, typename... Stages>
+    [[nodiscard]] auto to_vector(const Policy &policy, const VectorPipelineView<V, Stages...> &view) {
+        return to_vector(view, detail::pipeline_thread_count(policy, view));
+    }
+
+    namespace views {
+        /// @brief Each vector divided by its length (vectors must be non-zero).
+        inline constexpr VectorPipeline<detail::NormalizeStage> normalized{detail::NormalizeStage{}};
+
+        /// @brief Each vector multiplied by `factor`.
+        template<typename S>
+            requires std::is_arithmetic_v<S>
+        [[nodiscard]] constexpr auto scaled(S factor) {
+            return VectorPipeline(detail::ScaleStage<S>{factor});
+        }
+
+        /// @brief Each vector plus `offset`.
+        template<unsigned int Dim, typename T>
+        [[nodiscard]] constexpr auto translated(const Vector<Dim, T> &offset) {
+            return VectorPipeline(detail::TranslateStage<Dim, T>{offset});
+        }
+
+        /// @brief Projection of each vector onto `axis` (must be non-zero), like `Vector::project`.
+        template<unsigned int Dim, typename T>
+            requires std::is_floating_point_v<T>
+        [[nodiscard]] constexpr auto project_onto(const Vector<Dim, T> &axis) {
+            const auto squared = axis.squared_mag();
+            assert(squared > 0 && "Cannot project onto a zero vector.");
+            return VectorPipeline(detail::ProjectStage<Dim, T>{axis, squared});
+        }
+
+        /**
+         * @name Transforms
+         * Points get the translation (and the perspective divide of a 4x4 matrix), directions
+         * only the linear part, like the `Point` and `Direction` overloads of `transform`.
+         * @{
+         */
+        template<typename T>
+        [[nodiscard]] constexpr auto transform_points(const Matrix<4, 4, T> &m) {
+            return VectorPipeline(detail::MatrixStage<T, true>{m});
+        }
+
+        template<typename T>
+        [[nodiscard]] constexpr auto transform_points(const Transform3<T> &t) {
+            return VectorPipeline(detail::AffineStage<T, true>{t});
+        }
+
+        template<typename T>
+        [[nodiscard]] constexpr auto transform_directions(const Matrix<4, 4, T> &m) {
+            return VectorPipeline(detail::MatrixStage<T, false>{m});
+        }
+
+        template<typename T>
+        [[nodiscard]] constexpr auto transform_directions(const Transform3<T> &t) {
+            return VectorPipeline(detail::AffineStage<T, false>{t});
+        }
+
+        /** @} */
+    } // namespace views
+} // namespace Geometry
+
+#endif // VECTORVIEWS_H